@@ -2,6 +2,8 @@ from __future__ import annotations
 
 from typing import *
 from ctypes import *
+import array
+import time
 import Class
 
 
@@ -20,6 +22,37 @@ class CLib:
     """
     # Dictionary containing all loaded DLL.
     __LIBC: Dict[str, CDLL] = {}
+    # Element type codes understood by MatOp.so. Must match the DType enum in MatOp.c.
+    __DTYPE: Dict[Any, int] = {c_long: 0, c_double: 1, c_int: 2, c_float: 3}
+    # Elementwise operator codes understood by MatOp.so. Must match the EwOp enum in MatOp.c.
+    __EWOP: Dict[str, int] = {'add': 0, 'sub': 1, 'mul': 2, 'div': 3, 'flrdiv': 4, 'pow': 5, 'mod': 6, 'neg': 7,
+                              'lt': 8, 'le': 9, 'gt': 10, 'ge': 11, 'eq': 12, 'ne': 13}
+    # Elementwise operators whose results are boolean.
+    __EWCMP: Final[Set[str]] = {'lt', 'le', 'gt', 'ge', 'eq', 'ne'}
+    # Elementwise operators which divide by their RHS. A zero divisor must stay on the Python path:
+    # the native kernels would trap(integer division) or quietly produce inf/nan(double division),
+    # whereas Python raises ZeroDivisionError, which the interpreter reports as a kernel error.
+    __EWDIV: Final[Set[str]] = {'div', 'flrdiv', 'mod'}
+    # Elementwise operators EWFUSE can fuse into one pass. Comparisons stay eager: they change the element
+    # type to boolean, which the fused stack (and the lazy buffer representation) does not carry.
+    __EWFUSABLE: Final[Set[str]] = {'add', 'sub', 'mul', 'div', 'flrdiv', 'pow', 'mod', 'neg'}
+    # Maximum # of operand pushes in one fused program. Must not exceed FUSE_STK in MatOp.c.
+    __EWFUSE_MAX: Final[int] = 16
+    # Reduction operator codes understood by MatOp.so. Must match the RdOp enum in MatOp.c.
+    __RDOP: Dict[str, int] = {'sum': 0, 'prod': 1, 'dot': 2, 'nrm1': 3, 'nrm2': 4, 'nrmInf': 5, 'min': 6, 'max': 7}
+    # Reduction operators which always compute in double.
+    __RDFLT: Final[Set[str]] = {'nrm1', 'nrm2', 'nrmInf'}
+    # Blocking parameters of the parallel kernels.
+    # Values below are fallback defaults; init replaces them with the per-machine profile (refer to TUNE).
+    __PROFILE: Dict[str, int] = {'blkSz': 500, 'pnlSz': 128}
+    # Location of the persisted per-machine tuning profile. Delete the file to force recalibration.
+    __PROF_PATH: Final[str] = './CDLL/MatOp.profile'
+    # Kernel names reported by STATS. Must match the StatKer enum in MatOp.c, in order.
+    __STKER: Final[List[str]] = ['GEMM', 'GEMM_BATCH', 'GEMM_STRA', 'SYRK', 'TRSM', 'SOLVE', 'DET', 'INV', 'LU',
+                                 'CHOL', 'QR', 'EWISE', 'EWFUSE', 'REDUCE', 'TRANS']
+    # Python-side marshaling counters: bytes moved and seconds spent converting b/w Mat and flat buffers.
+    # The native kernel counters live in MatOp.so; STATS merges both views.
+    __MARSHAL: Dict[str, Union[int, float]] = {'bytes': 0, 'sec': 0.0}
 
     def __init__(self) -> None:
         raise NotImplementedError
@@ -30,34 +63,241 @@ class CLib:
         Loads DLL.
 
         MatOp.so contains the following matrix operation algorithms.
-            void GEMM(const void **A, const void **B, void **C, int l, int m, int n, int blkSz, _Bool int_mat)
-            void LU(double **A, int *p, int *q, int *flag, int m, int n, _Bool cp, double tol)
-            void CHOL(double **A, int *flag, int n, double tol)
-            void QR(double **A, double *v, int *flag, int m, int n, double tol)
+            void GEMM(const void *A, const void *B, void *C, int l, int m, int n, int ldA, int ldB, int ldC,
+                      int blkSz, int dt)
+            void SYRK(const double *A, double *C, int m, int n, int ldA, int ldC, int blkSz)
+            void GEMM_STRA(const double *A, const double *B, double *C, int l, int m, int n, int ldA, int ldB,
+                           int ldC, int blkSz)
+            void GEMM_BATCH(const void **A, const void **B, void **C, const int *l, const int *m, const int *n,
+                            int cnt, int dt)
+            void TRSM(const double *A, double *B, int n, int nrhs, int ldA, int ldB, _Bool lower, _Bool unit,
+                      int blkSz)
+            void SOLVE(double *A, double *B, int *flag, int n, int nrhs, int ldA, int ldB, double tol)
+            void DET(double *A, double *det, int *flag, int n, int ld, double tol)
+            void EWISE(const void *A, const void *B, void *C, long n, int op, int dt, int bcast)
+            void REDUCE(const void *A, const void *B, void *res, long *idx, long n, int op, int dt)
+            void TRANS(const void *A, void *B, long m, long n, int dt)
+            void INV(double *A, double *B, int *flag, int n, int ldA, int ldB, double tol)
+            void LU(double *A, int *p, int *q, int *flag, int m, int n, int ld, _Bool cp, double tol)
+            void CHOL(double *A, int *flag, int n, int ld, double tol)
+            void QR(double *A, double *v, int *flag, int m, int n, int ld, double tol)
+            void STATS_GET(long *cnt, double *sec, double *busy, long *nTask)
+            void STATS_RESET(void)
+
+        All matrices are passed as flat row-major buffers with explicit leading dimensions.
+        The (i, j) entry of an m by n matrix A with leading dimension ld resides at A[i * ld + j].
+        Compared to the previous array-of-rows representation, this needs just one allocation per matrix
+        and keeps all elements contiguous in memory, which the kernels exploit.
+
+        MatOp.so runs its parallel kernels on a process-lifetime worker thread pool.
+        The pool is spun up here, right after the DLL is loaded, via
+            void POOL_INIT(int nWorker)
+        Passing a nonpositive worker count lets the DLL size the pool to # of hardware cores.
+
+        The blocking parameters of the kernels depend on the cache hierarchy of the machine,
+        so after loading, the per-machine tuning profile is read (or calibrated at first use, refer to TUNE)
+        and the block size of the factorizations is pushed into the DLL via
+            void TUNE_SET(int pnlBlk)
         """
         cls.__LIBC['MatOp'] = CDLL('./CDLL/MatOp.so')
 
-        cls.__LIBC['MatOp'].GEMM.argtype = [POINTER(c_void_p), POINTER(c_void_p), POINTER(c_void_p), c_int, c_int,
-                                            c_int, c_int, c_bool]
-        cls.__LIBC['MatOp'].LU.argtype = [POINTER(c_void_p), POINTER(c_int), POINTER(c_int), POINTER(c_int), c_int,
-                                          c_int, c_bool, c_double]
-        cls.__LIBC['MatOp'].CHOL.argtype = [POINTER(c_void_p), POINTER(c_int), c_int, c_double]
-        cls.__LIBC['MatOp'].QR.argtype = [POINTER(c_void_p), POINTER(c_double), POINTER(c_int), c_int, c_int, c_double]
+        cls.__LIBC['MatOp'].POOL_INIT.argtype = [c_int]
+        cls.__LIBC['MatOp'].POOL_INIT(0)
+
+        cls.__LIBC['MatOp'].GEMM.argtype = [c_void_p, c_void_p, c_void_p, c_int, c_int, c_int, c_int, c_int, c_int,
+                                            c_int, c_int]
+        cls.__LIBC['MatOp'].SYRK.argtype = [POINTER(c_double), POINTER(c_double), c_int, c_int, c_int, c_int, c_int]
+        cls.__LIBC['MatOp'].GEMM_STRA.argtype = [POINTER(c_double), POINTER(c_double), POINTER(c_double), c_int, c_int,
+                                                 c_int, c_int, c_int, c_int, c_int]
+        cls.__LIBC['MatOp'].GEMM_BATCH.argtype = [POINTER(c_void_p), POINTER(c_void_p), POINTER(c_void_p),
+                                                  POINTER(c_int), POINTER(c_int), POINTER(c_int), c_int, c_int]
+        cls.__LIBC['MatOp'].TRSM.argtype = [POINTER(c_double), POINTER(c_double), c_int, c_int, c_int, c_int, c_bool,
+                                            c_bool, c_int]
+        cls.__LIBC['MatOp'].SOLVE.argtype = [POINTER(c_double), POINTER(c_double), POINTER(c_int), c_int, c_int, c_int,
+                                             c_int, c_double]
+        cls.__LIBC['MatOp'].DET.argtype = [POINTER(c_double), POINTER(c_double), POINTER(c_int), c_int, c_int,
+                                           c_double]
+        cls.__LIBC['MatOp'].EWISE.argtype = [c_void_p, c_void_p, c_void_p, c_long, c_int, c_int, c_int]
+        cls.__LIBC['MatOp'].EWFUSE.argtype = [POINTER(c_void_p), POINTER(c_long), c_long, c_void_p, c_long, c_int]
+        cls.__LIBC['MatOp'].REDUCE.argtype = [c_void_p, c_void_p, c_void_p, POINTER(c_long), c_long, c_int, c_int]
+        cls.__LIBC['MatOp'].TRANS.argtype = [c_void_p, c_void_p, c_long, c_long, c_int]
+        cls.__LIBC['MatOp'].INV.argtype = [POINTER(c_double), POINTER(c_double), POINTER(c_int), c_int, c_int, c_int,
+                                           c_double]
+        cls.__LIBC['MatOp'].LU.argtype = [POINTER(c_double), POINTER(c_int), POINTER(c_int), POINTER(c_int), c_int,
+                                          c_int, c_int, c_bool, c_double]
+        cls.__LIBC['MatOp'].CHOL.argtype = [POINTER(c_double), POINTER(c_int), c_int, c_int, c_double]
+        cls.__LIBC['MatOp'].QR.argtype = [POINTER(c_double), POINTER(c_double), POINTER(c_int), c_int, c_int, c_int,
+                                          c_double]
+        cls.__LIBC['MatOp'].TUNE_SET.argtype = [c_int]
+        cls.__LIBC['MatOp'].STATS_GET.argtype = [POINTER(c_long), POINTER(c_double), POINTER(c_double),
+                                                 POINTER(c_long)]
+
+        if not cls.__TuneLoad():
+            cls.TUNE()
+
+        cls.__LIBC['MatOp'].TUNE_SET(cls.__PROFILE['pnlSz'])
+
+    @classmethod
+    def __TuneLoad(cls) -> bool:
+        """
+        Loads the persisted tuning profile into __PROFILE.
+
+        The profile is a plain text file of key=value lines, one per parameter of __PROFILE.
+        Unknown keys are ignored so old profiles keep working when parameters are added.
+
+        :return: True iff the profile exists and parses; False asks the caller to calibrate from scratch.
+        """
+        try:
+            with open(cls.__PROF_PATH) as profile:
+                for line in profile:
+                    line = line.strip()
+
+                    if len(line) == 0 or line.startswith('#'):
+                        continue
+
+                    key, _, val = line.partition('=')
+
+                    if key in cls.__PROFILE:
+                        cls.__PROFILE[key] = int(val)
+        except (OSError, ValueError):
+            return False
+
+        return True
+
+    @classmethod
+    def TUNE(cls) -> NoReturn:
+        """
+        Calibrates the blocking parameters of MatOp.so for this machine and persists the winners.
+
+        The right block size depends on the cache hierarchy and core count of the machine,
+        which is why hardcoding one guess leaves throughput on the table on every new instance type.
+        This sweeps a few candidates against the actual kernels:
+            blkSz: block size of the parallel GEMM family, timed on a synthetic square multiplication.
+            pnlSz: block size of the trailing updates inside the blocked factorizations, timed on LU.
+        Each candidate is timed twice and judged by its better run to dampen scheduling noise.
+
+        The winners are stored in __PROFILE and written to __PROF_PATH,
+        so the sweep runs once per machine rather than once per process.
+        Deleting the profile file forces recalibration at the next init.
+        """
+        # The probe must be strictly larger than every candidate: a candidate at or above
+        # the probe size degenerates to one serial block, and its timing is indistinguishable
+        # from every other oversized candidate, so the winner would be pure noise.
+        n = 768
+        flat = array.array('d', [(i * 16807 % 10007) / 10007 - 0.5 for i in range(n * n)])
+        A: Array = (c_double * (n * n)).from_buffer(flat)
+        C: Array = (c_double * (n * n))()
+        best = None
+
+        for blk in [128, 192, 256, 384, 512]:
+            tm = None
+
+            for _ in range(2):
+                start = time.perf_counter()
+                cls.__LIBC['MatOp'].GEMM(A, A, C, n, n, n, n, n, n, blk, cls.__DTYPE[c_double])
+                tm = min(tm, time.perf_counter() - start) if tm is not None else time.perf_counter() - start
+
+            if best is None or tm < best[1]:
+                best = blk, tm
+
+        cls.__PROFILE['blkSz'] = best[0]
+
+        # The LU probe can stay smaller: every pnlSz candidate is well below it,
+        # and the O(n^3) factorization would make the larger probe needlessly slow.
+        n = 384
+        flat = flat[:n * n]
+        best = None
+
+        for pnl in [64, 128, 256]:
+            cls.__LIBC['MatOp'].TUNE_SET(pnl)
+            tm = None
+
+            for _ in range(2):
+                B: Array = (c_double * (n * n)).from_buffer(array.array('d', flat))
+
+                for i in range(n):
+                    B[i * n + i] += n
+
+                p: Array = (c_int * n)(*[i for i in range(n)])
+                flag = POINTER(c_int)(c_int())
+                start = time.perf_counter()
+
+                cls.__LIBC['MatOp'].LU(B, p, None, flag, n, n, n, c_bool(False), c_double(1e-10))
+
+                tm = min(tm, time.perf_counter() - start) if tm is not None else time.perf_counter() - start
+
+            if best is None or tm < best[1]:
+                best = pnl, tm
+
+        cls.__PROFILE['pnlSz'] = best[0]
+
+        try:
+            with open(cls.__PROF_PATH, 'w') as profile:
+                profile.write('# MatOp tuning profile. Generated by CLib.TUNE; delete to recalibrate.\n')
+
+                for key, val in cls.__PROFILE.items():
+                    profile.write(f'{key}={val}\n')
+        except OSError:
+            # A read-only install still works; the sweep just reruns next process.
+            pass
+
+    @classmethod
+    def STATS(cls, reset: bool = False) -> Dict[str, Tuple[Union[int, float], float]]:
+        """
+        Reads the hot-path instrumentation counters.
+
+        MatOp.so counts every kernel invocation and its wall time, plus how long the pool workers
+        spent inside tasks; this class additionally tracks the bytes and seconds of Mat-to-buffer
+        marshaling on the Python side. Together they answer where a slow job put its time:
+        marshaling, thread scheduling (kernel wall time far above summed busy time), or arithmetic.
+        Kernels called internally by other kernels (GEMM inside LU and QR, TRSM inside SOLVE)
+        are counted at each invocation, so the per-kernel times overlap.
+
+        If MatOp.so was compiled with -DMATOP_STATS=0, all native counters read zero.
+
+        :param reset: If true, all counters are cleared after being read. (Default: False)
+
+        :return: Dictionary from counter name to a (count, seconds) pair.
+                 Kernel entries count invocations, 'pool' counts tasks against worker busy seconds,
+                 and 'marshal' counts bytes against conversion seconds.
+        """
+        cnt: Array = (c_long * len(cls.__STKER))()
+        sec: Array = (c_double * len(cls.__STKER))()
+        busy = POINTER(c_double)(c_double())
+        task = POINTER(c_long)(c_long())
+
+        cls.__LIBC['MatOp'].STATS_GET(cnt, sec, busy, task)
+
+        res: Dict[str, Tuple[Union[int, float], float]] = {kernel: (cnt[i], sec[i])
+                                                           for i, kernel in enumerate(cls.__STKER)}
+        res['pool'] = (task.contents.value, busy.contents.value)
+        res['marshal'] = (cls.__MARSHAL['bytes'], cls.__MARSHAL['sec'])
+
+        if reset:
+            cls.__LIBC['MatOp'].STATS_RESET()
+            cls.__MARSHAL['bytes'] = 0
+            cls.__MARSHAL['sec'] = 0.0
+
+        return res
 
     """
     TYPE CASTING LOGIC
-    
+
     The logic below is for internal use only.
     """
 
-    @staticmethod
-    def __C2Mat(m: Array, d: List[int], trans: bool = False) -> Class.Array.Mat:
+    @classmethod
+    def __C2Mat(cls, m: Array, d: List[int], trans: bool = False) -> Class.Array.Mat:
         """
-        Converts a matrix represented as a double array(double pointer) in C to a Mat class in Python.
+        Converts a matrix represented as a flat row-major buffer in C to a Mat class in Python.
+
+        The buffer is assumed to be tightly packed, ie. its leading dimension is d[1].
 
         Flag trans indicates whether transpose is needed or not.
         For some numerical algorithms, especially when the size of matrix is large,
         transposing matrix before computation and transpose the result again is profitable by reducing cache miss.
+        The transpose itself runs through the cache-oblivious TRANS kernel on the flat buffer
+        instead of gathering strided elements one by one in Python.
 
         :param m: C representation of a matrix to be converted.
         :param d: Dimension of matrix m.
@@ -66,9 +306,36 @@ class CLib:
         :return: Converted matrix.
         """
         if trans:
-            return Class.Array.Mat([Class.Array.Vec([m[j][i] for j in range(d[0])]) for i in range(d[1])], [d[1], d[0]])
+            t: Any = type(m)._type_
+
+            if t not in [c_long, c_double]:
+                return Class.Array.Mat([Class.Array.Vec([m[j * d[1] + i] for j in range(d[0])]) for i in range(d[1])],
+                                       [d[1], d[0]])
+
+            res: Array = (t * (d[0] * d[1]))()
+
+            cls.__LIBC['MatOp'].TRANS(m, res, c_long(d[0]), c_long(d[1]), cls.__DTYPE[t])
+
+            m, d = res, [d[1], d[0]]
+
+        start: float = time.perf_counter()
+        t: Any = type(m)._type_
+
+        # For the common long and double cases, the result stays in its flat form:
+        # the buffer is copied once into an array and wrapped by Mat.from_buf, which builds no rows at all.
+        # The nested lists are materialized lazily iff something actually reads the elements.
+        if t == c_long or t == c_double:
+            a: array.array = array.array('q' if t == c_long else 'd')
+            a.frombytes(memoryview(m).cast('B'))
+            res: Class.Array.Mat = Class.Array.Mat.from_buf(a, t, d.copy())
         else:
-            return Class.Array.Mat([Class.Array.Vec([m[i][j] for j in range(d[1])]) for i in range(d[0])], d.copy())
+            # Slicing the ctypes buffer extracts a whole row per call instead of one element per call.
+            res = Class.Array.Mat([Class.Array.Vec(m[i * d[1]:(i + 1) * d[1]]) for i in range(d[0])], d.copy())
+
+        cls.__MARSHAL['bytes'] += d[0] * d[1] * sizeof(type(m)._type_)
+        cls.__MARSHAL['sec'] += time.perf_counter() - start
+
+        return res
 
     @staticmethod
     def __C2Vec(v: Array, d: int) -> Class.Array.Vec:
@@ -82,10 +349,13 @@ class CLib:
         """
         return Class.Array.Vec([v[i] for i in range(d)])
 
-    @staticmethod
-    def __Mat2C(m: Class.Array.Mat, t: Any = None, trans: bool = False) -> Tuple[Array, Any]:
+    @classmethod
+    def __Mat2C(cls, m: Class.Array.Mat, t: Any = None, trans: bool = False, mut: bool = False) -> Tuple[Array, Any]:
         """
-        Converts a matrix represented as a Mat class in Python to a double array(double pointer) in C.
+        Converts a matrix represented as a Mat class in Python to a flat row-major buffer in C.
+
+        The returned buffer is tightly packed, ie. its leading dimension is # of columns,
+        and is allocated as one contiguous block.
 
         Parameter t indicates the type of elements of a matrix.
         Unlike Python, C strictly differentiates integer and floating point value.
@@ -94,24 +364,67 @@ class CLib:
         If a matrix contains at least one floating point value, then all elements will be casted to double in C.
         For flag trans, refer to the comments of __C2Mat.
 
+        For the common long and double cases, the flat buffer is filled through the array module
+        (refer to the comments of __EWMarshal) and handed to C via from_buffer,
+        which validates and converts all elements in one C-level pass
+        instead of pushing each element through a ctypes constructor argument.
+
+        The flat buffer is cached on the Mat itself (refer to Mat.buf_get) and reused on later calls
+        as long as the elements have not been mutated, so repeated native calls on the same matrix
+        and chains of native results pay the O(elements) conversion only once.
+        Kernels which overwrite their input must pass flag mut to receive a private copy of the buffer;
+        sharing the cache with an in-place kernel would desynchronize it from the elements.
+
         :param m: Mat object to be converted.
         :param t: Type of elements in matrix m. (Default: None)
         :param trans: If true, transpose the input matrix m. (Default: False)
+        :param mut: If true, the kernel will overwrite the buffer. (Default: False)
 
         :return: Converted matrix.
         """
+        if trans:
+            src, t = cls.__Mat2C(m, t)
+
+            if t not in [c_long, c_double]:
+                return (t * (m.dim[0] * m.dim[1]))(*[m[j][i] for i in range(m.dim[1]) for j in range(m.dim[0])]), t
+
+            res: Array = (t * (m.dim[0] * m.dim[1]))()
+
+            cls.__LIBC['MatOp'].TRANS(src, res, c_long(m.dim[0]), c_long(m.dim[1]), cls.__DTYPE[t])
+
+            return res, t
+
+        cached = m.buf_get()
+
+        if cached is not None and (t is None or t == cached[1]):
+            a, t = cached
+
+            if mut:
+                copy: array.array = array.array(cls.__TCode(a))
+                copy.frombytes(a.tobytes())
+                a = copy
+
+            return (t * len(a)).from_buffer(a), t
+
+        flat: List = [it for row in m.elem for it in row.elem]
+        a = cls.__EWMarshal(flat)
+        # The cache must hold the natural element type of the matrix;
+        # a buffer converted for an explicit type request would poison later untyped calls.
+        natural: bool = a is not None and (t is None or (t == c_long) == (a.typecode == 'q'))
+
         if t is None:
-            t = c_long if all([all([type(it) == int for it in row]) for row in m.elem]) else c_double
+            t = c_long if a is not None and a.typecode == 'q' else c_double
 
-        if trans:
-            m, n = m.dim[1], m.dim[0]
+        if a is not None and t == c_double and a.typecode == 'q':
+            a = array.array('d', a)
 
-            return (POINTER(t) * m)(*[(t * n)(*[m[j][i] for j in range(n)]) for i in range(m)]), t
+        if a is not None and ((t == c_long and a.typecode == 'q') or (t == c_double and a.typecode == 'd')):
+            if natural and not mut:
+                m.buf_set(a, t)
 
-        else:
-            m, n = m.dim[0], m.dim[1]
+            return (t * len(flat)).from_buffer(a), t
 
-            return (POINTER(t) * m)(*[(t * n)(*[m[i][j] for j in range(n)]) for i in range(m)]), t
+        return (t * len(flat))(*flat), t
 
     """
     WRAPPER
@@ -122,7 +435,8 @@ class CLib:
     """
 
     @classmethod
-    def GEMM(cls, A: Class.Array.Mat, B: Class.Array.Mat, blk_sz: int) -> Class.Array.Mat:
+    def GEMM(cls, A: Class.Array.Mat, B: Class.Array.Mat, blk_sz: Optional[int] = None, single: bool = False,
+             strassen: bool = False) -> Class.Array.Mat:
         """
         General matrix multiplication.
 
@@ -133,30 +447,784 @@ class CLib:
         If blk_sz is too small, overhead of fetching new thread overwhelms the benefit of parallel computing.
         If blk_sz is too large, blocked matrices will be too large to benefit from multithreading.
         So it must be determined with care and may depend on one's system.
+        When blk_sz is omitted, the value measured for this machine by the autotuner is used (refer to TUNE),
+        which is what all the built-in operators do.
 
-        Since GEMM does not involve any floating point arithmetic,
-        it supports two versions, one for an integer matrix and one for a floating point matrix.
+        It supports four element types: long, double, int32, and float32.
         It checks types of elements and cast elements to long in C iff all elements are integer.
         Otherwise, all elements will be casted to double in C.
+        With flag single, the narrow 32-bit variants (int32/float32) are used instead,
+        halving memory traffic and doubling effective SIMD width
+        at the price of possible overflow (int32) or roundoff (float32).
+
+        With flag strassen, very large multiplications run through the recursive Strassen algorithm.
+        The recursion halves all three dimensions and trades one multiplication for extra additions per level;
+        sub-blocks under a fixed cutoff fall back to the blocked kernels,
+        so small matrices pay nothing for the mode.
+        Strassen mode always computes in double precision.
 
         :param A: LHS of matrix multiplication.
         :param B: RHS of matrix multiplication.
-        :param blk_sz: Block size for parallel computing.
+        :param blk_sz: Block size for parallel computing. (Default: None, meaning the tuned profile value)
+        :param single: If true, compute in the 32-bit element types. (Default: False)
+        :param strassen: If true, use the recursive Strassen algorithm. (Default: False)
 
         :return: A * B.
         """
+        if blk_sz is None:
+            blk_sz = cls.__PROFILE['blkSz']
+
         l, m, n = A.nrow, A.ncol, B.ncol
-        A, t1 = cls.__Mat2C(A)
-        B, t2 = cls.__Mat2C(B)
+        A_, t1 = cls.__Mat2C(A)
+        B_, t2 = cls.__Mat2C(B)
         t: Any = c_long if t1 == t2 == c_long else c_double
-        C: Array = (POINTER(t) * l)(*[(t * n)() for _ in range(l)])
 
-        cls.__LIBC['MatOp'].GEMM(A, B, C, l, m, n, blk_sz, t == c_long)
+        if strassen:
+            t = c_double
+        elif single:
+            t = c_int if t == c_long else c_float
+
+        # In case of mixed or narrowed element types, operands must be re-marshaled to match the kernel.
+        if t1 != t:
+            A_, _ = cls.__Mat2C(A, t)
+
+        if t2 != t:
+            B_, _ = cls.__Mat2C(B, t)
+
+        A, B = A_, B_
+        C: Array = (t * (l * n))()
+
+        if strassen:
+            cls.__LIBC['MatOp'].GEMM_STRA(A, B, C, l, m, n, m, n, n, blk_sz)
+        else:
+            cls.__LIBC['MatOp'].GEMM(A, B, C, l, m, n, m, n, n, blk_sz, cls.__DTYPE[t])
 
         return cls.__C2Mat(C, [l, n])
 
     @classmethod
-    def LU(cls, A: Class.Array.Mat, cp: bool, tol: float) -> Union[
+    def GEMM_batch(cls, A: List[Class.Array.Mat], B: List[Class.Array.Mat],
+                   single: bool = False) -> List[Class.Array.Mat]:
+        """
+        Batched general matrix multiplication.
+
+        Computes A[i] * B[i] for every pair in the batch with one native call.
+        Going through GEMM one pair at a time pays a ctypes round trip and a scheduling round trip per product,
+        which dominates when matrices are small.
+        Here all operands are marshaled in one pass and the whole batch is fanned across the worker pool at once,
+        with one task per product.
+
+        The element type is chosen once for the entire batch following the same promotion rule as GEMM:
+        long iff every element of every operand is integer, double otherwise.
+        For flag single, refer to the comments of GEMM.
+
+        :param A: List of LHS matrices.
+        :param B: List of RHS matrices. Must have the same length as A.
+        :param single: If true, compute in the 32-bit element types. (Default: False)
+
+        :return: List of products A[i] * B[i].
+        """
+        cnt: int = len(A)
+        t: Any = c_long if all([all([all([type(it) == int for it in row]) for row in m.elem]) for m in A + B]) \
+            else c_double
+
+        if single:
+            t = c_int if t == c_long else c_float
+
+        bufA: List[Array] = [cls.__Mat2C(m, t)[0] for m in A]
+        bufB: List[Array] = [cls.__Mat2C(m, t)[0] for m in B]
+        bufC: List[Array] = [(t * (A[i].nrow * B[i].ncol))() for i in range(cnt)]
+        l: Array = (c_int * cnt)(*[m.nrow for m in A])
+        m_: Array = (c_int * cnt)(*[m.ncol for m in A])
+        n: Array = (c_int * cnt)(*[m.ncol for m in B])
+        ptrA: Array = (c_void_p * cnt)(*[cast(b, c_void_p) for b in bufA])
+        ptrB: Array = (c_void_p * cnt)(*[cast(b, c_void_p) for b in bufB])
+        ptrC: Array = (c_void_p * cnt)(*[cast(b, c_void_p) for b in bufC])
+
+        cls.__LIBC['MatOp'].GEMM_BATCH(ptrA, ptrB, ptrC, l, m_, n, cnt, cls.__DTYPE[t])
+
+        return [cls.__C2Mat(bufC[i], [A[i].nrow, B[i].ncol]) for i in range(cnt)]
+
+    @staticmethod
+    def __TCode(buf: Any) -> str:
+        """
+        Typecode of a flat buffer.
+
+        Cached flat buffers are array.array instances, except for memory mapped matrices
+        (refer to the comments of MatFun.load) which enter the cache as typed memoryviews.
+        Both expose the same one character element codes, just under different attribute names.
+
+        :param buf: Flat buffer.
+
+        :return: 'q' for long buffers, 'd' for double buffers.
+        """
+        return buf.typecode if type(buf) == array.array else buf.format
+
+    @classmethod
+    def __EWMarshal(cls, flat: List) -> Optional[array.array]:
+        """
+        Marshals a flat element list for EWISE in one native pass.
+
+        The array module both validates and converts at C speed:
+        building a 'q' array succeeds iff every element is an integer(or boolean),
+        and building a 'd' array succeeds iff every element is numeric.
+        This replaces two Python-level type scans plus a ctypes constructor call per operand,
+        which together used to cost more than the kernel itself.
+
+        :param flat: Flat list of elements.
+
+        Successful conversions are charged to the marshaling counters reported by STATS.
+
+        :return: Typecode 'q' array for all-integer input, 'd' array for numeric input,
+                 or None if some element is not numeric.
+        """
+        start: float = time.perf_counter()
+
+        try:
+            res: Optional[array.array] = array.array('q', flat)
+        except (TypeError, OverflowError):
+            try:
+                res = array.array('d', flat)
+            except TypeError:
+                return None
+
+        cls.__MARSHAL['bytes'] += res.itemsize * len(res)
+        cls.__MARSHAL['sec'] += time.perf_counter() - start
+
+        return res
+
+    @classmethod
+    def __EWBuf(cls, m: Class.Array.Mat) -> Optional[array.array]:
+        """
+        Fetches the flat buffer of a matrix(vector) operand for EWISE and REDUCE.
+
+        A valid cached buffer(refer to the comments of Mat.buf_get) is reused as is,
+        which makes chained elementwise operations marshal-free:
+        each native result already carries its buffer, so only the very first operand of a chain pays.
+        On a cache miss the elements are flattened through __EWMarshal
+        and the fresh buffer is installed back into the cache for the next call.
+        Note that buf_get forces any pending elementwise expression first,
+        so lazy results(refer to EWLAZY) are transparent here.
+
+        :param m: Matrix or vector operand.
+
+        :return: Typecode 'q' or 'd' array over the elements of m, or None if some element is not numeric.
+        """
+        cached: Optional[Tuple[array.array, Any]] = m.buf_get()
+
+        if cached is not None and cached[1] in (c_long, c_double):
+            return cached[0]
+
+        flat: List = m.elem if type(m) == Class.Array.Vec else [it for row in m.elem for it in row.elem]
+        a: Optional[array.array] = cls.__EWMarshal(flat)
+
+        if a is not None:
+            m.buf_set(a, c_long if a.typecode == 'q' else c_double)
+
+        return a
+
+    @classmethod
+    def EWISE(cls, A: Class.Array.Mat, B: Any, op: str, swap: bool = False) -> Optional[Class.Array.Mat]:
+        """
+        Elementwise operation.
+
+        Computes A op B componentwise over flat buffers on the native side, where B is either a matrix(vector)
+        of the same shape as A or a single scalar which is broadcast to every element.
+        With flag swap, operands are reversed (B op A), which backs the reflected operators of Arr.
+        For op 'neg', B is ignored altogether.
+
+        The element type follows the promotion rule of GEMM: long iff every element is integer, double otherwise,
+        except that true division always computes in double.
+        Note that with a mixed matrix, integer elements thus come back as floats,
+        whereas the pure Python path keeps per-element types. This matches the vector semantics of R.
+        Comparison results are converted back to booleans.
+
+        Unlike other wrappers, this one DOES check its inputs,
+        because the operator overloads of Arr probe it with whatever they are given:
+        if shapes differ, some element is not numeric,
+        or the operation cannot preserve integer semantics natively(integer pow), it returns None
+        and the caller falls back to the pure Python path.
+
+        :param A: LHS operand.
+        :param B: RHS operand: a matrix(vector) of the same shape as A, a scalar, or None for op 'neg'.
+        :param op: Operator name. A key of __EWOP.
+        :param swap: If true, compute B op A instead. (Default: False)
+
+        :return: Result with the shape of A, or None if the native path is not applicable.
+        """
+        a: Optional[array.array] = cls.__EWBuf(A)
+
+        if a is None:
+            return None
+
+        if isinstance(B, Class.Array.Arr):
+            if type(B) not in (Class.Array.Mat, Class.Array.Vec) or B.dim != A.dim:
+                return None
+
+            b: Optional[array.array] = cls.__EWBuf(B)
+            bcast: int = 0
+        elif op == 'neg':
+            b, bcast = array.array('q', [0]), 1
+        else:
+            if not isinstance(B, (int, float)):
+                return None
+
+            b, bcast = cls.__EWMarshal([B]), 2 if swap else 1
+
+        if b is None:
+            return None
+
+        is_int: bool = cls.__TCode(a) == cls.__TCode(b) == 'q' and op != 'div'
+
+        if op == 'pow' and is_int:
+            # Integer pow may legitimately produce floats (negative exponents); leave it to Python.
+            return None
+
+        if not is_int:
+            a = array.array('d', a) if cls.__TCode(a) == 'q' else a
+            b = array.array('d', b) if cls.__TCode(b) == 'q' else b
+
+        t: Any = c_long if is_int else c_double
+        n: int = len(a)
+
+        if swap:
+            a, b = b, a
+
+        # After the swap the divisor is always b. A zero divisor falls back to the Python path,
+        # so dividing by zero raises the same ZeroDivisionError regardless of operand size
+        # (refer to the comments of __EWDIV).
+        if op in cls.__EWDIV and 0 in b:
+            return None
+
+        c: array.array = array.array('q' if is_int else 'd', bytes(8 * n))
+
+        cls.__LIBC['MatOp'].EWISE((t * len(a)).from_buffer(a), (t * len(b)).from_buffer(b),
+                                  (t * n).from_buffer(c), c_long(n), cls.__EWOP[op], cls.__DTYPE[t], bcast)
+
+        if op in cls.__EWCMP:
+            res: List = list(map(bool, c))
+
+            if type(A) == Class.Array.Vec:
+                return Class.Array.Vec(res)
+
+            ncol: int = A.dim[1]
+
+            return Class.Array.Mat([Class.Array.Vec(res[i * ncol:(i + 1) * ncol]) for i in range(A.dim[0])],
+                                   A.dim.copy())
+
+        # Arithmetic results are already sitting in the array c; wrap it without building any rows.
+        if type(A) == Class.Array.Vec:
+            return Class.Array.Vec.from_buf(c, t)
+
+        return Class.Array.Mat.from_buf(c, t, A.dim.copy())
+
+    @staticmethod
+    def __EWInt(opnd: Any) -> bool:
+        """
+        Decides whether an operand of a lazy elementwise expression is integer.
+
+        Matches the promotion rule of EWISE:
+        a buffer operand is integer iff its typecode is 'q',
+        a scalar operand iff it is a Python integer(or boolean) representable as a long,
+        and a nested expression node carries the flag it was built with.
+
+        :param opnd: Operand triple(refer to the comments of EWLAZY).
+
+        :return: True iff the operand is integer.
+        """
+        if opnd[0] == 'op':
+            return opnd[5]
+
+        if opnd[0] == 'num':
+            return isinstance(opnd[1], int) and -2 ** 63 <= opnd[1] < 2 ** 63
+
+        return CLib.__TCode(opnd[1]) == 'q'
+
+    @staticmethod
+    def __EWPush(opnd: Any) -> int:
+        """
+        Counts the operand pushes a lazy elementwise expression will emit.
+
+        Nested expression nodes carry their count; leaves push once.
+        The count bounds the evaluation stack depth of the fused kernel,
+        hence EWLAZY refuses chains exceeding __EWFUSE_MAX pushes.
+
+        :param opnd: Operand triple(refer to the comments of EWLAZY).
+
+        :return: The number of pushes.
+        """
+        return opnd[4] if opnd[0] == 'op' else 1
+
+    @classmethod
+    def __EWOpnd(cls, m: Class.Array.Mat) -> Optional[Tuple]:
+        """
+        Captures a matrix(vector) operand for a lazy elementwise expression.
+
+        A pending operand contributes its expression node, so chains fuse into one program.
+        Otherwise the flat buffer is fetched(and cached) as in __EWBuf.
+        Capturing the buffer EAGERLY is what makes laziness safe:
+        even if the variable holding m is reassigned before the expression is forced,
+        the captured buffer still holds the values m had at capture time.
+
+        :param m: Matrix or vector operand.
+
+        :return: Operand triple, or None if some element is not numeric.
+        """
+        e: Optional[Tuple] = m.expr_get()
+
+        if e is not None:
+            return e
+
+        a: Optional[array.array] = cls.__EWBuf(m)
+
+        if a is None:
+            return None
+
+        # The expression reads the buffer only when forced, which may be arbitrarily later;
+        # mark the capture so the in-place factorization mode cannot overwrite it meanwhile
+        # (refer to Mat.buf_share).
+        m.buf_share()
+
+        return ('buf', a)
+
+    @classmethod
+    def EWLAZY(cls, A: Class.Array.Mat, B: Any, op: str, swap: bool = False) -> Optional[Class.Array.Mat]:
+        """
+        Lazy elementwise operation.
+
+        Instead of computing A op B, builds an expression node recording the operation
+        and returns a PENDING matrix(vector) holding it.
+        Chained arithmetic like A + B * C - D thus accumulates one expression tree,
+        and the first demand for elements(printing, indexing, use as a native operand)
+        evaluates the whole tree through the fused kernel EWFUSE in a single memory pass,
+        instead of streaming each intermediate result through memory separately.
+
+        Operands and applicability rules mirror EWISE, with two extra bail-outs:
+        comparison operators never fuse(their results must come back as booleans),
+        and chains whose operand pushes exceed __EWFUSE_MAX fall back
+        so the kernel evaluation stack stays bounded.
+        Whenever this returns None the caller simply falls through to EWISE.
+
+        Expression nodes are tuples ('op', name, a, b, pushes, is_int)
+        whose operands a and b are nested nodes, captured buffers ('buf', array)
+        or broadcast scalars ('num', v); for op 'neg', b is None.
+
+        :param A: LHS operand.
+        :param B: RHS operand: a matrix(vector) of the same shape as A, a scalar, or None for op 'neg'.
+        :param op: Operator name. A key of __EWOP.
+        :param swap: If true, record B op A instead. (Default: False)
+
+        :return: Pending result with the shape of A, or None if fusion is not applicable.
+        """
+        if op not in cls.__EWFUSABLE:
+            return None
+
+        a: Optional[Tuple] = cls.__EWOpnd(A)
+
+        if a is None:
+            return None
+
+        if isinstance(B, Class.Array.Arr):
+            if type(B) not in (Class.Array.Mat, Class.Array.Vec) or B.dim != A.dim:
+                return None
+
+            b: Optional[Tuple] = cls.__EWOpnd(B)
+
+            if b is None:
+                return None
+        elif op == 'neg':
+            b = None
+        else:
+            if not isinstance(B, (int, float)):
+                return None
+
+            b = ('num', B)
+
+        if op in cls.__EWDIV:
+            d: Tuple = a if swap else b
+
+            # A pending divisor would have to be forced to screen it, which defeats laziness;
+            # bail out and let the eager path force and screen it instead.
+            if d[0] == 'op':
+                return None
+
+            # Same zero screening as EWISE: a fused program must never divide by zero
+            # (refer to the comments of __EWDIV). Captured buffers are snapshots, so a divisor
+            # vetted here cannot grow a zero before the expression is forced.
+            if (d[1] == 0) if d[0] == 'num' else (0 in d[1]):
+                return None
+
+        is_int: bool = cls.__EWInt(a) and (b is None or cls.__EWInt(b)) and op != 'div'
+
+        if op == 'pow' and is_int:
+            # Integer pow may legitimately produce floats (negative exponents); leave it to Python.
+            return None
+
+        pushes: int = cls.__EWPush(a) + (0 if b is None else cls.__EWPush(b))
+
+        if pushes > cls.__EWFUSE_MAX:
+            return None
+
+        if swap:
+            a, b = b, a
+
+        node: Tuple = ('op', op, a, b, pushes, is_int)
+
+        if type(A) == Class.Array.Vec:
+            return Class.Array.Vec.from_expr(node, A.dim[0])
+
+        return Class.Array.Mat.from_expr(node, A.dim.copy())
+
+    @classmethod
+    def __EWLin(cls, opnd: Any, tc: str, opnds: List[array.array], seen: Dict[int, int],
+                prog: List[int]) -> NoReturn:
+        """
+        Linearizes a lazy elementwise expression into the postfix program EWFUSE executes.
+
+        A program entry e >= 0 pushes operand e >> 1 onto the kernel stack
+        (bit 0 set marks a broadcast scalar, which is read with stride 0);
+        an entry e < 0 applies elementwise operation -(e + 1), a value of the EwOp enum on the native side.
+        Repeated buffer operands(e.g. A in A * A) are deduplicated by identity,
+        and integer buffers feeding a double program are converted here, once per distinct operand.
+
+        :param opnd: Operand triple to linearize(refer to the comments of EWLAZY).
+        :param tc: Typecode of the program, 'q' or 'd'.
+        :param opnds: Accumulator for the operand buffers.
+        :param seen: Map from captured buffer id to its index in opnds, for deduplication.
+        :param prog: Accumulator for the program entries.
+        """
+        if opnd[0] == 'op':
+            cls.__EWLin(opnd[2], tc, opnds, seen, prog)
+
+            if opnd[3] is not None:
+                cls.__EWLin(opnd[3], tc, opnds, seen, prog)
+
+            prog.append(-(cls.__EWOP[opnd[1]] + 1))
+        elif opnd[0] == 'num':
+            opnds.append(array.array(tc, [opnd[1]]))
+            prog.append((len(opnds) - 1) << 1 | 1)
+        else:
+            k: Optional[int] = seen.get(id(opnd[1]), None)
+
+            if k is None:
+                k = len(opnds)
+                seen[id(opnd[1])] = k
+                opnds.append(array.array('d', opnd[1]) if tc == 'd' and cls.__TCode(opnd[1]) == 'q' else opnd[1])
+
+            prog.append(k << 1)
+
+    @classmethod
+    def EWFUSE(cls, node: Tuple, n: int) -> Tuple[array.array, Any]:
+        """
+        Evaluates a lazy elementwise expression in one fused native pass.
+
+        The expression tree built by EWLAZY is linearized into a postfix program
+        (refer to the comments of __EWLin) which the kernel interprets blockwise:
+        every FUSE_BLK elements of the result are computed keeping all intermediates
+        in a small stack of registers-sized blocks, so however long the chain is,
+        each operand is read once and the result is written once.
+
+        Unlike EWLAZY, this does NOT check anything: it is called from the forcing logic of Mat
+        (refer to Mat.buf_get) with a node EWLAZY already vetted.
+
+        :param node: Root expression node.
+        :param n: Number of elements of the result.
+
+        :return: Tuple of the flat result buffer and its ctypes element type.
+        """
+        is_int: bool = node[5]
+        tc: str = 'q' if is_int else 'd'
+        t: Any = c_long if is_int else c_double
+
+        opnds: List[array.array] = []
+        prog: List[int] = []
+
+        cls.__EWLin(node, tc, opnds, {}, prog)
+
+        c: array.array = array.array(tc, bytes(8 * n))
+        ptrs: Array = (c_void_p * len(opnds))(*[addressof(c_char.from_buffer(o)) for o in opnds])
+
+        cls.__LIBC['MatOp'].EWFUSE(ptrs, (c_long * len(prog))(*prog), c_long(len(prog)),
+                                   (t * n).from_buffer(c), c_long(n), cls.__DTYPE[t])
+
+        return c, t
+
+    @classmethod
+    def REDUCE(cls, A: Class.Array.Mat, op: str, B: Any = None) -> Optional[Tuple[Any, int]]:
+        """
+        Reduction over all elements.
+
+        Supported reductions are sum, prod, dot(which takes B as its second operand),
+        the 1-, 2- and sup-norms(nrm1/nrm2/nrmInf), and min/max.
+        Elements are streamed through the native kernels in parallel chunks whose partial results
+        are combined once at the end, so the whole pass costs one marshal and one native call.
+
+        The element type follows the promotion rule of GEMM: long iff every element is integer, double otherwise,
+        except that norms always compute in double.
+        For min and max, the second member of the returned tuple is the flat row-major position
+        of the first extremum; for all other reductions it is -1.
+
+        Like EWISE, this wrapper DOES check its inputs and returns None when some element is not numeric
+        or the operand lengths of dot differ, letting the caller fall back or raise as appropriate.
+
+        :param A: Operand.
+        :param op: Reduction name. A key of __RDOP.
+        :param B: Second operand of dot. (Default: None)
+
+        :return: Tuple of the reduction result and the index described above, or None if not applicable.
+        """
+        a: Optional[array.array] = cls.__EWBuf(A)
+
+        if a is None or len(a) == 0:
+            return None
+
+        if op == 'dot':
+            b: Optional[array.array] = cls.__EWBuf(B)
+
+            if b is None or len(b) != len(a):
+                return None
+        else:
+            b = array.array(cls.__TCode(a), [0])
+
+        is_int: bool = cls.__TCode(a) == cls.__TCode(b) == 'q' and op not in cls.__RDFLT
+
+        if not is_int:
+            a = array.array('d', a) if cls.__TCode(a) == 'q' else a
+            b = array.array('d', b) if cls.__TCode(b) == 'q' else b
+
+        t: Any = c_long if is_int else c_double
+        n: int = len(a)
+        res: Array = (t * 1)()
+        idx = POINTER(c_long)(c_long())
+
+        cls.__LIBC['MatOp'].REDUCE((t * len(a)).from_buffer(a), (t * len(b)).from_buffer(b), res, idx,
+                                   c_long(n), cls.__RDOP[op], cls.__DTYPE[t])
+
+        return res[0], idx.contents.value
+
+    @classmethod
+    def TRANS(cls, A: Class.Array.Mat) -> Class.Array.Mat:
+        """
+        Matrix transpose.
+
+        The element movement runs through the native TRANS kernel,
+        which recursively halves the longer dimension of the matrix (cache-oblivious blocking)
+        so that both the read and the write side stay within cache at the base case,
+        and splits large matrices into row slices processed in parallel by the pool.
+        A naive doubly nested loop writes with a stride of the full row length instead,
+        which makes transposing a large matrix slower than multiplying it.
+
+        Elements stay long in C iff every element is integer; otherwise they are casted to double.
+
+        :param A: Matrix to be transposed.
+
+        :return: A'.
+        """
+        m, n = A.nrow, A.ncol
+        A, t = cls.__Mat2C(A)
+        B: Array = (t * (m * n))()
+
+        cls.__LIBC['MatOp'].TRANS(A, B, c_long(m), c_long(n), cls.__DTYPE[t])
+
+        return cls.__C2Mat(B, [n, m])
+
+    @classmethod
+    def SYRK(cls, A: Class.Array.Mat, blk_sz: Optional[int] = None) -> Class.Array.Mat:
+        """
+        Symmetric crossproduct.
+
+        For m by n matrix A, it computes the n by n Gram matrix A'A.
+        Since the result is symmetric, the kernel computes only tiles on or above the diagonal
+        and mirrors them into the lower triangle,
+        which costs half the FLOPs of transposing A in Python and multiplying with GEMM.
+        Like other parallel kernels, computation is divided into blocks of size blk_sz.
+        Refer to the comments of GEMM for guidance on blk_sz.
+
+        All elements are casted to double in C regardless of their Python types.
+
+        :param A: Matrix whose crossproduct is to be computed.
+        :param blk_sz: Block size for parallel computing. (Default: None, meaning the tuned profile value)
+
+        :return: A'A.
+        """
+        if blk_sz is None:
+            blk_sz = cls.__PROFILE['blkSz']
+
+        m, n = A.nrow, A.ncol
+        A, _ = cls.__Mat2C(A, c_double)
+        C: Array = (c_double * (n * n))()
+
+        cls.__LIBC['MatOp'].SYRK(A, C, m, n, n, n, blk_sz)
+
+        return cls.__C2Mat(C, [n, n])
+
+    @classmethod
+    def TRSM(cls, A: Class.Array.Mat, B: Class.Array.Mat, lower: bool, unit: bool,
+             blk_sz: Optional[int] = None) -> Class.Array.Mat:
+        """
+        Triangular solve with multiple right hand sides.
+
+        For n by n triangular matrix A and n by nrhs matrix B, it computes X with A * X = B
+        by forward(lower triangular A) or backward(upper triangular A) substitution.
+        Only the relevant triangle of A is referenced, so the other triangle may hold arbitrary values,
+        which allows solving directly against the compact outputs of LU and CHOL.
+        With flag unit, the diagonal of A is taken to be all ones and the stored diagonal is ignored.
+
+        Right hand side columns are independent, so the kernel cuts B into column tiles of width blk_sz
+        and solves them in parallel. Refer to the comments of GEMM for guidance on blk_sz.
+
+        All elements are casted to double in C regardless of their Python types.
+
+        :param A: Triangular coefficient matrix.
+        :param B: Right hand side matrix.
+        :param lower: If true, A is lower triangular. Otherwise, A is upper triangular.
+        :param unit: If true, A has an implicit unit diagonal.
+        :param blk_sz: Block size for parallel computing. (Default: None, meaning the tuned profile value)
+
+        :return: Solution X of A * X = B.
+        """
+        if blk_sz is None:
+            blk_sz = cls.__PROFILE['blkSz']
+
+        n, nrhs = B.nrow, B.ncol
+        A, _ = cls.__Mat2C(A, c_double)
+        B, _ = cls.__Mat2C(B, c_double, mut=True)
+
+        cls.__LIBC['MatOp'].TRSM(A, B, n, nrhs, n, nrhs, c_bool(lower), c_bool(unit), blk_sz)
+
+        return cls.__C2Mat(B, [n, nrhs])
+
+    @classmethod
+    def SOLVE(cls, A: Class.Array.Mat, B: Class.Array.Mat, tol: float) -> Tuple[Class.Array.Mat, int]:
+        """
+        Solves the linear system A * X = B.
+
+        For non-singular n by n matrix A and n by nrhs matrix B, the whole solve runs in one native call:
+        partial-pivoting LU of A, row permutation of B, then unit lower and upper triangular solves.
+        Chaining the steps in C avoids marshaling the intermediate factors back and forth,
+        which would otherwise cost one full matrix conversion per step.
+
+        If A is singular, the internal LU encounters a zero pivot and stops.
+        In that case, the flag is set as the column index where it stopped and the returned matrix is meaningless.
+        In case of a successful solve, the flag will be set as # of columns, n.
+
+        All elements are casted to double in C regardless of their Python types.
+
+        :param A: Coefficient matrix.
+        :param B: Right hand side matrix.
+        :param tol: Tolerance value. If abs(x) < tol, then x will be considered as 0.
+
+        :return: Solution X of A * X = B and the flag described above.
+        """
+        n, nrhs = B.nrow, B.ncol
+        A, _ = cls.__Mat2C(A, c_double, mut=True)
+        B, _ = cls.__Mat2C(B, c_double, mut=True)
+        flag = POINTER(c_int)(c_int())
+
+        cls.__LIBC['MatOp'].SOLVE(A, B, flag, n, nrhs, n, nrhs, c_double(tol))
+
+        return cls.__C2Mat(B, [n, nrhs]), flag.contents.value
+
+    @classmethod
+    def DET(cls, A: Class.Array.Mat, tol: float) -> Tuple[float, int]:
+        """
+        Determinant.
+
+        For n by n matrix A, the determinant is computed through partial-pivoting LU decomposition:
+        it is the product of the diagonal entries of U, sign-corrected by the parity of the row permutation.
+        The whole computation stays in native code and only the scalar result crosses back to Python,
+        so no intermediate matrix is ever converted.
+
+        If A is singular, the internal LU encounters a zero pivot, the determinant is exactly zero,
+        and the flag is set as the column index where the LU stopped.
+        In case of a successful decomposition, the flag will be set as # of columns, n.
+
+        All elements are casted to double in C regardless of their Python types.
+
+        :param A: Matrix whose determinant is to be computed.
+        :param tol: Tolerance value. If abs(x) < tol, then x will be considered as 0.
+
+        :return: Determinant of A and the flag described above.
+        """
+        n: int = A.nrow
+        A, _ = cls.__Mat2C(A, c_double, mut=True)
+        det = POINTER(c_double)(c_double())
+        flag = POINTER(c_int)(c_int())
+
+        cls.__LIBC['MatOp'].DET(A, det, flag, n, n, c_double(tol))
+
+        return det.contents.value, flag.contents.value
+
+    @classmethod
+    def INV(cls, A: Class.Array.Mat, tol: float) -> Tuple[Class.Array.Mat, int]:
+        """
+        Matrix inverse.
+
+        For non-singular n by n matrix A, the inverse is computed as a multi right hand side identity solve:
+        the identity is filled in native code and handed to SOLVE,
+        so the factorization, permutation and both triangular solves all happen in one native pass.
+
+        If A is singular, the internal LU encounters a zero pivot and stops.
+        In that case, the flag is set as the column index where it stopped and the returned matrix is meaningless.
+        In case of a successful solve, the flag will be set as # of columns, n.
+
+        All elements are casted to double in C regardless of their Python types.
+
+        :param A: Matrix to be inverted.
+        :param tol: Tolerance value. If abs(x) < tol, then x will be considered as 0.
+
+        :return: Inverse of A and the flag described above.
+        """
+        n: int = A.nrow
+        A, _ = cls.__Mat2C(A, c_double, mut=True)
+        B: Array = (c_double * (n * n))()
+        flag = POINTER(c_int)(c_int())
+
+        cls.__LIBC['MatOp'].INV(A, B, flag, n, n, n, c_double(tol))
+
+        return cls.__C2Mat(B, [n, n]), flag.contents.value
+
+    @classmethod
+    def __InBuf(cls, m: Class.Array.Mat) -> Optional[Any]:
+        """
+        Fetches the flat buffer of m for an in-place factorization.
+
+        The kernels factor in double, so only a double buffer can be taken over;
+        an integer (or non-numeric) matrix returns None and the caller falls back
+        to the copying path of __Mat2C.
+
+        :param m: Matrix to be factored in place.
+
+        :return: Double flat buffer of m, or None if in-place factorization is not applicable.
+        """
+        buf: Optional[Any] = cls.__EWBuf(m)
+
+        # A buffer captured by a pending expression must not be overwritten before the force,
+        # and a matrix packed into a struct stays reachable through the struct
+        # even after its variable bindings are consumed;
+        # fall back to the copying path in both cases (refer to Mat.buf_share and Mat.buf_pack).
+        return buf if buf is not None and cls.__TCode(buf) == 'd' and not m.buf_shared() and not m.buf_packed() \
+            else None
+
+    @classmethod
+    def __InWrap(cls, src: Class.Array.Mat, buf: Any, dim: List[int]) -> Class.Array.Mat:
+        """
+        Wraps the factored result of an in-place kernel around the buffer it overwrote.
+
+        The buffer is taken over from src, whose cache is detached (refer to Mat.buf_drop)
+        so that no later native call on src can read the factored contents through the stale cache.
+
+        :param src: Matrix the buffer was taken from.
+        :param buf: Overwritten flat buffer now holding the result.
+        :param dim: Dimension of the result.
+
+        :return: Result matrix backed by buf.
+        """
+        src.buf_drop()
+
+        return Class.Array.Mat.from_buf(buf, c_double, dim)
+
+    @classmethod
+    def LU(cls, A: Class.Array.Mat, cp: bool, tol: float, inplace: bool = False) -> Union[
         Tuple[Class.Array.Mat, Class.Array.Vec, Class.Array.Vec, int],
         Tuple[Class.Array.Mat, Class.Array.Vec, int]]:
         """
@@ -181,27 +1249,44 @@ class CLib:
         a vector indicating permutation of rows, and the flag described above.
         In case of complete pivoting, it returns one more vector which indicates permutation of columns.
 
+        With flag inplace, the kernel factors the flat buffer of A DIRECTLY
+        and the result is wrapped around that very buffer, so neither the defensive input copy
+        nor the result marshal is paid: peak memory stays at one matrix.
+        A is left overwritten; the caller is responsible for consuming its bindings
+        (refer to SymTab.consume_v and MatFun.lu).
+        An integer matrix cannot be factored inside its own long buffer
+        and silently falls back to the copying path.
+
         :param A: Matrix to be LU decomposed.
         :param cp: If true, complete pivoting is employed. Otherwise, partial pivoting is used.
         :param tol: Tolerance value. If abs(x) < tol, then x will be considered as 0.
+        :param inplace: If true, factor the buffer of A in place as described above. (Default: False)
 
         :return: Refer to the paragraph 3 in the comments above.
         """
         m, n = A.nrow, A.ncol
-        A, _ = cls.__Mat2C(A, c_double)
-        p: Array = (c_int * n)(*[i for i in range(m)])
+        src, buf = A, cls.__InBuf(A) if inplace else None
+
+        if buf is None:
+            a, _ = cls.__Mat2C(A, c_double, mut=True)
+        else:
+            a = (c_double * (m * n)).from_buffer(buf)
+
+        p: Array = (c_int * m)(*[i for i in range(m)])
         q: Array = (c_int * n)(*[i for i in range(n)]) if cp else None
         flag = POINTER(c_int)(c_int())
 
-        cls.__LIBC['MatOp'].LU(A, p, q, flag, m, n, c_double(tol))
+        cls.__LIBC['MatOp'].LU(a, p, q, flag, m, n, n, c_bool(cp), c_double(tol))
+
+        res: Class.Array.Mat = cls.__InWrap(src, buf, [m, n]) if buf is not None else cls.__C2Mat(a, [m, n])
 
         if cp:
-            return cls.__C2Mat(A, [m, n]), cls.__C2Vec(p, m), cls.__C2Vec(q, n), flag.contents.value
+            return res, cls.__C2Vec(p, m), cls.__C2Vec(q, n), flag.contents.value
         else:
-            return cls.__C2Mat(A, [m, n]), cls.__C2Vec(p, m), flag.contents.value
+            return res, cls.__C2Vec(p, m), flag.contents.value
 
     @classmethod
-    def CHOL(cls, A: Class.Array.Mat, tol: float) -> Tuple[Class.Array.Mat, int]:
+    def CHOL(cls, A: Class.Array.Mat, tol: float, inplace: bool = False) -> Tuple[Class.Array.Mat, int]:
         """
         Cholesky decomposition.
 
@@ -219,18 +1304,30 @@ class CLib:
 
         It returns a matrix in which the elements of L are stored in a compact form and the flag described above.
 
+        With flag inplace, the kernel factors the flat buffer of A directly;
+        refer to the comments of LU for the contract.
+
         :param A: Matrix to be Cholesky decomposed.
         :param tol: Tolerance value. If abs(x) < tol, then x will be considered as 0.
+        :param inplace: If true, factor the buffer of A in place. (Default: False)
 
         :return: Refer to the paragraph 3 in the comments above.
         """
         n: int = A.nrow
-        A, _ = cls.__Mat2C(A, c_double)
+        src, buf = A, cls.__InBuf(A) if inplace else None
+
+        if buf is None:
+            a, _ = cls.__Mat2C(A, c_double, mut=True)
+        else:
+            a = (c_double * (n * n)).from_buffer(buf)
+
         flag = POINTER(c_int)(c_int())
 
-        cls.__LIBC['MatOp'].CHOL(A, flag, n, c_double(tol))
+        cls.__LIBC['MatOp'].CHOL(a, flag, n, n, c_double(tol))
+
+        res: Class.Array.Mat = cls.__InWrap(src, buf, [n, n]) if buf is not None else cls.__C2Mat(a, [n, n])
 
-        return cls.__C2Mat(A, [n, n]), flag.contents.value
+        return res, flag.contents.value
 
     @classmethod
     def QR(cls, A: Class.Array.Mat, tol: float) -> Tuple[Class.Array.Mat, Class.Array.Vec, int]:
@@ -264,7 +1361,7 @@ class CLib:
         v: Array = (c_double * m)(*[c_double() for _ in range(m)])
         flag = POINTER(c_int)(c_int())
 
-        cls.__LIBC['MatOp'].QR(A, v, flag, m, n, c_double(tol))
+        cls.__LIBC['MatOp'].QR(A, v, flag, m, n, n, c_double(tol))
 
         return cls.__C2Mat(A, [m, n], True), cls.__C2Vec(v, m), flag.contents.value
 
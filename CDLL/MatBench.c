@@ -0,0 +1,391 @@
+#include<stdlib.h>
+#include<stdio.h>
+#include<string.h>
+#include<math.h>
+#include<time.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/wait.h>
+
+/*
+ * Benchmark driver for MatOp.so.
+ *
+ * It exercises GEMM (double and float32), LU, CHOL and QR across a size and thread-count grid,
+ * validates every run against reference results, and reports one CSV line per run:
+ *     kernel,dtype,n,threads,blkSz,seconds,gflops,gbps,eff,maxErr,check
+ * where eff is the parallel efficiency against the single-thread run of the same kernel and size,
+ * and gbps is a lower-bound traffic model (each operand touched once).
+ * Machine-readable on purpose: pipe it into whatever tracks kernel performance across commits.
+ *
+ * The worker pool of MatOp.so is sized once per process and cannot shrink,
+ * so each thread count runs in a forked child; results come back through a shared mapping
+ * and the parent prints everything at the end.
+ *
+ * Usage: MatBench [maxN] [blkSz]
+ *     maxN: largest matrix extent of the grid. (Default: 1024)
+ *     blkSz: block size handed to the kernels. (Default: 256)
+ */
+
+/* Entry points of MatOp.c. There is no shared header; keep these in sync with the prototypes there. */
+void POOL_INIT(int nWorker);
+void TUNE_SET(int pnlBlk);
+void GEMM(const void *A, const void *B, void *C, int l, int m, int n, int ldA, int ldB, int ldC, int blkSz, int dt);
+void LU(double *A, int *p, int *q, int *flag, int m, int n, int ld, _Bool cp, double tol);
+void CHOL(double *A, int *flag, int n, int ld, double tol);
+void QR(double *A, double *v, int *flag, int m, int n, int ld, double tol);
+
+/* Must match the DType enum in MatOp.c. */
+#define DT_DOUBLE 1
+#define DT_FLT32 3
+
+#define MAX_SZ 3
+#define MAX_THR 16
+#define N_KER 5
+#define SAMPLE 64
+
+typedef struct _BenchRes {
+    double sec;
+    double err;
+} BenchRes;
+
+static const int benchSz[MAX_SZ] = {256, 512, 1024};
+static const char *kerName[N_KER] = {"GEMM", "GEMM", "LU", "CHOL", "QR"};
+static const char *kerType[N_KER] = {"double", "flt32", "double", "double", "double"};
+
+/* Deterministic fill so every run and every process sees the same operands.
+ * The index is mixed through a 64-bit hash; a plain modular sequence repeats
+ * after its modulus and fills large matrices with nearly dependent rows. */
+static double __BenchElem(long i) {
+    unsigned long x = (unsigned long)i * 0x9E3779B97F4A7C15UL + 0xD1B54A32D192ED03UL;
+
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9UL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBUL;
+    x ^= x >> 31;
+
+    return (double)(x >> 11) / (double)(1UL << 53) - 0.5;
+}
+
+static double __BenchTick(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Sampled reference check: a handful of entries recomputed with the naive formula.
+ * Full reference products at every grid point would dwarf the benchmark itself. */
+static double __BenchGEMMD(int n, int blkSz, double *sec) {
+    double *A = (double *)malloc((size_t)n * n * sizeof(double));
+    double *B = (double *)malloc((size_t)n * n * sizeof(double));
+    double *C = (double *)calloc((size_t)n * n, sizeof(double));
+    double err = 0;
+
+    for (long i = 0; i < (long)n * n; i++) {
+        A[i] = __BenchElem(i);
+        B[i] = __BenchElem(i + 1);
+    }
+
+    *sec = __BenchTick();
+    GEMM(A, B, C, n, n, n, n, n, n, blkSz, DT_DOUBLE);
+    *sec = __BenchTick() - *sec;
+
+    for (int s = 0; s < SAMPLE; s++) {
+        int i = (s * 7919) % n;
+        int j = (s * 104729) % n;
+        double ref = 0;
+
+        for (int k = 0; k < n; k++) {
+            ref += A[i * n + k] * B[k * n + j];
+        }
+
+        err = fmax(err, fabs(C[i * n + j] - ref));
+    }
+
+    free(A);
+    free(B);
+    free(C);
+
+    return err;
+}
+
+static double __BenchGEMMF32(int n, int blkSz, double *sec) {
+    float *A = (float *)malloc((size_t)n * n * sizeof(float));
+    float *B = (float *)malloc((size_t)n * n * sizeof(float));
+    float *C = (float *)calloc((size_t)n * n, sizeof(float));
+    double err = 0;
+
+    for (long i = 0; i < (long)n * n; i++) {
+        A[i] = (float)__BenchElem(i);
+        B[i] = (float)__BenchElem(i + 1);
+    }
+
+    *sec = __BenchTick();
+    GEMM(A, B, C, n, n, n, n, n, n, blkSz, DT_FLT32);
+    *sec = __BenchTick() - *sec;
+
+    for (int s = 0; s < SAMPLE; s++) {
+        int i = (s * 7919) % n;
+        int j = (s * 104729) % n;
+        double ref = 0;
+
+        for (int k = 0; k < n; k++) {
+            ref += (double)A[i * n + k] * (double)B[k * n + j];
+        }
+
+        err = fmax(err, fabs((double)C[i * n + j] - ref));
+    }
+
+    free(A);
+    free(B);
+    free(C);
+
+    return err;
+}
+
+static double __BenchLU(int n, double *sec) {
+    double *A = (double *)malloc((size_t)n * n * sizeof(double));
+    double *F = (double *)malloc((size_t)n * n * sizeof(double));
+    int *p = (int *)malloc(n * sizeof(int));
+    int flag = -1;
+    double err = 0;
+
+    /* Diagonally dominant, so the factorization never stops early. */
+    for (long i = 0; i < (long)n * n; i++) {
+        A[i] = __BenchElem(i);
+    }
+
+    for (int i = 0; i < n; i++) {
+        A[(long)i * n + i] += n;
+        p[i] = i;
+    }
+
+    memcpy(F, A, (size_t)n * n * sizeof(double));
+
+    *sec = __BenchTick();
+    LU(F, p, NULL, &flag, n, n, n, 0, 1e-10);
+    *sec = __BenchTick() - *sec;
+
+    if (flag != n) {
+        err = 1e30;
+    }
+
+    /* Sampled PA = LU reconstruction. */
+    for (int s = 0; s < SAMPLE; s++) {
+        int i = (s * 7919) % n;
+        int j = (s * 104729) % n;
+        double ref = 0;
+
+        for (int k = 0; k <= (i < j ? i : j); k++) {
+            double l = k == i ? 1 : F[(long)i * n + k];
+
+            ref += l * F[(long)k * n + j];
+        }
+
+        err = fmax(err, fabs(ref - A[(long)p[i] * n + j]));
+    }
+
+    free(A);
+    free(F);
+    free(p);
+
+    return err;
+}
+
+static double __BenchCHOL(int n, double *sec) {
+    double *A = (double *)malloc((size_t)n * n * sizeof(double));
+    double *F = (double *)malloc((size_t)n * n * sizeof(double));
+    int flag = -1;
+    double err = 0;
+
+    /* Symmetric and diagonally dominant, hence positive definite. */
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            A[(long)i * n + j] = __BenchElem((long)(i < j ? i : j) * n + (i < j ? j : i));
+        }
+
+        A[(long)i * n + i] += n;
+    }
+
+    memcpy(F, A, (size_t)n * n * sizeof(double));
+
+    *sec = __BenchTick();
+    CHOL(F, &flag, n, n, 1e-12);
+    *sec = __BenchTick() - *sec;
+
+    if (flag != n) {
+        err = 1e30;
+    }
+
+    /* Sampled A = R'R reconstruction; the factor R sits in the upper triangle. */
+    for (int s = 0; s < SAMPLE; s++) {
+        int i = (s * 7919) % n;
+        int j = (s * 104729) % n;
+        double ref = 0;
+
+        for (int k = 0; k <= (i < j ? i : j); k++) {
+            ref += F[(long)k * n + i] * F[(long)k * n + j];
+        }
+
+        err = fmax(err, fabs(ref - A[(long)i * n + j]));
+    }
+
+    free(A);
+    free(F);
+
+    return err;
+}
+
+static double __BenchQR(int n, double *sec) {
+    double *A = (double *)malloc((size_t)n * n * sizeof(double));
+    double *v = (double *)malloc(n * sizeof(double));
+    int flag = -1;
+    double nrmA = 0;
+    double nrmR = 0;
+    double err;
+
+    for (long i = 0; i < (long)n * n; i++) {
+        A[i] = __BenchElem(i);
+        nrmA += A[i] * A[i];
+    }
+
+    *sec = __BenchTick();
+    QR(A, v, &flag, n, n, n, 1e-12);
+    *sec = __BenchTick() - *sec;
+
+    /* Orthogonal transformations preserve the Frobenius norm,
+     * so the triangular factor (on and below the diagonal in the compact layout)
+     * must carry exactly the norm of the input. */
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            nrmR += A[(long)i * n + j] * A[(long)i * n + j];
+        }
+    }
+
+    err = fabs(sqrt(nrmR) - sqrt(nrmA)) / sqrt(nrmA);
+
+    if (flag != n) {
+        err = 1e30;
+    }
+
+    free(A);
+    free(v);
+
+    return err;
+}
+
+/* FLOP counts of the standard algorithms and a one-touch-per-operand traffic model. */
+static double __BenchFlop(int ker, int n) {
+    double nd = n;
+
+    switch (ker) {
+    case 0:
+    case 1:
+        return 2 * nd * nd * nd;
+    case 2:
+        return 2 * nd * nd * nd / 3;
+    case 3:
+        return nd * nd * nd / 3;
+    default:
+        return 4 * nd * nd * nd / 3;
+    }
+}
+
+static double __BenchByte(int ker, int n) {
+    double nd = n;
+
+    return ker == 1 ? 3 * nd * nd * 4 : (ker == 0 ? 3 : 2) * nd * nd * 8;
+}
+
+static double __BenchRun(int ker, int n, int blkSz, double *sec) {
+    switch (ker) {
+    case 0:
+        return __BenchGEMMD(n, blkSz, sec);
+    case 1:
+        return __BenchGEMMF32(n, blkSz, sec);
+    case 2:
+        return __BenchLU(n, sec);
+    case 3:
+        return __BenchCHOL(n, sec);
+    default:
+        return __BenchQR(n, sec);
+    }
+}
+
+int main(int argc, char **argv) {
+    int maxN = argc > 1 ? atoi(argv[1]) : 1024;
+    int blkSz = argc > 2 ? atoi(argv[2]) : 256;
+    int nCpu = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int thr[MAX_THR];
+    int nThr = 0;
+    int nSz = 0;
+    BenchRes *res;
+
+    nCpu = nCpu > 0 ? nCpu : 1;
+
+    for (int t = 1; t <= nCpu && nThr < MAX_THR; t *= 2) {
+        thr[nThr++] = t;
+    }
+
+    if (thr[nThr - 1] != nCpu && nThr < MAX_THR) {
+        thr[nThr++] = nCpu;
+    }
+
+    while (nSz < MAX_SZ && benchSz[nSz] <= maxN) {
+        nSz++;
+    }
+
+    if (nSz == 0 || blkSz <= 0) {
+        fprintf(stderr, "usage: %s [maxN >= %d] [blkSz > 0]\n", argv[0], benchSz[0]);
+
+        return 1;
+    }
+
+    res = (BenchRes *)mmap(NULL, N_KER * nSz * nThr * sizeof(BenchRes), PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    /* The pool cannot be resized once spun up, so every thread count gets a fresh child.
+     * The shared mapping carries the timings back to the parent. */
+    for (int t = 0; t < nThr; t++) {
+        pid_t pid = fork();
+
+        if (pid == 0) {
+            POOL_INIT(thr[t]);
+            TUNE_SET(blkSz);
+
+            for (int ker = 0; ker < N_KER; ker++) {
+                for (int s = 0; s < nSz; s++) {
+                    BenchRes *r = &res[(ker * nSz + s) * nThr + t];
+
+                    r->err = __BenchRun(ker, benchSz[s], blkSz, &r->sec);
+                }
+            }
+
+            _exit(0);
+        }
+
+        waitpid(pid, NULL, 0);
+    }
+
+    printf("kernel,dtype,n,threads,blkSz,seconds,gflops,gbps,eff,maxErr,check\n");
+
+    for (int ker = 0; ker < N_KER; ker++) {
+        for (int s = 0; s < nSz; s++) {
+            double base = __BenchFlop(ker, benchSz[s]) / res[(ker * nSz + s) * nThr].sec;
+
+            for (int t = 0; t < nThr; t++) {
+                BenchRes *r = &res[(ker * nSz + s) * nThr + t];
+                double flops = __BenchFlop(ker, benchSz[s]) / r->sec;
+                double tol = strcmp(kerType[ker], "flt32") == 0 ? 1e-1 : 1e-6;
+
+                printf("%s,%s,%d,%d,%d,%.6f,%.3f,%.3f,%.3f,%.3e,%s\n", kerName[ker], kerType[ker], benchSz[s],
+                       thr[t], blkSz, r->sec, flops * 1e-9, __BenchByte(ker, benchSz[s]) / r->sec * 1e-9,
+                       flops / (base * thr[t]), r->err, r->err < tol * benchSz[s] ? "ok" : "FAIL");
+            }
+        }
+    }
+
+    munmap(res, N_KER * nSz * nThr * sizeof(BenchRes));
+
+    return 0;
+}
@@ -1,325 +1,2670 @@
+#define _GNU_SOURCE
+
 #include<stdlib.h>
 #include<stdio.h>
 #include<pthread.h>
+#include<sched.h>
 #include<math.h>
+#include<string.h>
+#include<time.h>
+#include<unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include<immintrin.h>
+#endif
+
+#define TRUE 1
+#define FALSE 0
+#define MIN(a, b) ((a) > (b) ? (b) : (a))
+
+/* Register tile of the packed microkernel: MR by NR elements of C held in registers. */
+#define MR 4
+#define NR 8
+/* Cache block along the inner-product dimension of the packed path. */
+#define KC 256
+/* The packed path pays for copying both operands into scratch.
+ * Below this inner-product length the plain loop wins, so stay scalar. */
+#define MICRO_MIN 32
+/* Panel width of the blocked factorizations. */
+#define PANEL_NB 64
+/* Default block size handed to GEMM for trailing updates inside the factorizations.
+ * The actual value lives in the runtime tunable tunePnl below, seeded with this default
+ * and overridden by TUNE_SET once CLibrary has calibrated the machine. */
+#define PANEL_BLK 128
+/* Chunk length of the parallel elementwise kernels. */
+#define EW_CHUNK (1 << 18)
+/* Block length and maximum stack depth of the fused elementwise interpreter.
+ * A block of values per stack slot keeps the inner loops straight-line and vectorizable;
+ * the whole stack stays under 32KB and fits in L1 together with one block of each operand. */
+#define FUSE_BLK 256
+#define FUSE_STK 16
+#define TR_BLK 32
+/* Sub-blocks of the Strassen recursion below this extent are multiplied by the blocked kernels instead.
+ * The cutoff keeps the recursion to the top one or two levels where the 1/8 FLOP saving actually pays. */
+#define STRA_MIN 256
+
+/*
+ * Element types the kernels understand.
+ * CLibrary picks the widest type needed by the operands, or the narrow 32-bit variants
+ * when the caller explicitly opts into single precision.
+ */
+typedef enum _DType {
+    DT_LONG = 0,
+    DT_DOUBLE = 1,
+    DT_INT32 = 2,
+    DT_FLT32 = 3
+} DType;
+
+/*
+ * Elementwise operators understood by EWISE.
+ * CLibrary mirrors these codes; comparisons write 0/1 into the output buffer.
+ */
+typedef enum _EwOp {
+    EW_ADD = 0,
+    EW_SUB = 1,
+    EW_MUL = 2,
+    EW_DIV = 3,
+    EW_FLR = 4,
+    EW_POW = 5,
+    EW_MOD = 6,
+    EW_NEG = 7,
+    EW_LT = 8,
+    EW_LE = 9,
+    EW_GT = 10,
+    EW_GE = 11,
+    EW_EQ = 12,
+    EW_NE = 13
+} EwOp;
+
+/*
+ * Reduction operators understood by REDUCE.
+ * CLibrary mirrors these codes; 2-norm partial sums hold squares, the square root is taken once at the end.
+ */
+typedef enum _RdOp {
+    RD_SUM = 0,
+    RD_PROD = 1,
+    RD_DOT = 2,
+    RD_NRM1 = 3,
+    RD_NRM2 = 4,
+    RD_NRMINF = 5,
+    RD_MIN = 6,
+    RD_MAX = 7
+} RdOp;
+
+/* Partial result of one reduction chunk: one slot per task, combined serially by the driver. */
+typedef struct _RdPart {
+    double f;
+    long l;
+    long idx;
+} RdPart;
+
+/*
+ * All kernels operate on flat row-major buffers with explicit leading dimensions.
+ * An m by n matrix A with leading dimension ldA stores its (i, j) entry at A[i * ldA + j].
+ * This keeps rows contiguous so that streaming through a matrix touches memory sequentially.
+ */
+
+typedef struct _Data {
+    const void * __restrict__ A;
+    const void * __restrict__ B;
+    void * __restrict__ C;
+    int dim[3];
+    int ld[3];
+} Data;
+
+typedef struct _Task {
+    void *(*run)(void *);
+    void *arg;
+    struct _Task *next;
+    struct _Task *prev;
+} Task;
+
+/* Per-worker task deque. Refer to the pool comments below. */
+typedef struct _WkQ {
+    Task *head;
+    Task *tail;
+    pthread_mutex_t mtx;
+} WkQ;
+
+/*
+ * Process-lifetime worker pool with work stealing.
+ *
+ * Workers are spun up once by POOL_INIT (called when CLibrary loads this DLL) and live until the process dies.
+ * Kernels submit their blocks as tasks instead of creating one thread per block,
+ * so repeated calls do not pay thread start/teardown over and over again.
+ *
+ * Each worker owns a deque; submissions are dealt round-robin across the deques,
+ * a worker pops its own deque from the FRONT (so it walks its blocks in submission order,
+ * which for the tiled kernels means adjacent tiles and warm caches)
+ * and, once its own deque runs dry, steals from the BACK of the other deques
+ * (the blocks farthest from where the victim is currently working).
+ * Equal-weight dealing is thus only the starting point: edge blocks and the shrinking
+ * trailing updates of the factorizations finish early and their workers immediately
+ * drain the stragglers instead of idling, without every pop fighting over one global lock.
+ *
+ * Workers are pinned round-robin to cores at startup. Besides stopping the OS from
+ * migrating a worker away from its warm cache, pinning fixes NUMA placement:
+ * the scratch arenas below are thread-local and faulted in by the worker itself,
+ * so first touch places each slab on the memory node of the core the worker is pinned to.
+ *
+ * taskAvail counts submitted-but-unclaimed tasks and is the sleep/wake gate;
+ * taskPend counts submitted-but-unfinished tasks and is what __POOLWait blocks on.
+ */
+static pthread_t *poolWorker;
+static WkQ *poolQ;
+static int poolSz = 0;
+static int poolRR = 0;
+static int taskPend = 0;
+static int taskAvail = 0;
+static pthread_mutex_t poolMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t taskCond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t doneCond = PTHREAD_COND_INITIALIZER;
+
+void POOL_INIT(int nWorker);
+
+#if defined(__x86_64__) || defined(__i386__)
+static int __SIMDOk(void);
+#endif
+
+/*
+ * Runtime-tunable blocking.
+ *
+ * The right block size depends on the cache hierarchy of the machine, which is unknown at compile time.
+ * CLibrary calibrates it at first use (sweeping candidates and persisting the winner to a profile file)
+ * and pushes the measured value in through TUNE_SET; until then the compile-time default applies.
+ * tunePnl is the block size the blocked factorizations (LU, CHOL, QR, SOLVE) hand to their trailing updates.
+ */
+static int tunePnl = PANEL_BLK;
+
+void TUNE_SET(int pnlBlk) {
+    if (pnlBlk > 0) {
+        tunePnl = pnlBlk;
+    }
+
+    return;
+}
+
+/*
+ * Hot-path instrumentation.
+ *
+ * Every exported kernel bumps an invocation counter and accumulates its wall time on the way out;
+ * the worker loop additionally tracks how long threads spend inside tasks, which separates
+ * arithmetic from scheduling: a kernel whose wall time far exceeds the summed busy time of its tasks
+ * is waiting on the pool, not computing.
+ * Counters of kernels called internally by other kernels (GEMM inside LU and QR, TRSM inside SOLVE)
+ * include those nested invocations, so the per-kernel times overlap and do not sum to total runtime.
+ *
+ * Compiling with -DMATOP_STATS=0 strips every probe; STATS_GET then reports all zeros.
+ * The kernel counters are only touched from the caller's thread, so they need no synchronization;
+ * the busy counters are shared between workers and use relaxed atomics.
+ */
+#ifndef MATOP_STATS
+#define MATOP_STATS 1
+#endif
+
+enum StatKer {
+    ST_GEMM = 0,
+    ST_GEMM_BATCH,
+    ST_GEMM_STRA,
+    ST_SYRK,
+    ST_TRSM,
+    ST_SOLVE,
+    ST_DET,
+    ST_INV,
+    ST_LU,
+    ST_CHOL,
+    ST_QR,
+    ST_EWISE,
+    ST_EWFUSE,
+    ST_REDUCE,
+    ST_TRANS,
+    ST_NKER
+};
+
+#if MATOP_STATS
+
+static long statCnt[ST_NKER];
+static double statSec[ST_NKER];
+static long statBusyNs = 0;
+static long statTask = 0;
+
+static double __StatTick(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#define STAT_ENTER double statT0 = __StatTick()
+#define STAT_LEAVE(ker) do { statCnt[ker]++; statSec[ker] += __StatTick() - statT0; } while (0)
+
+#else
+
+#define STAT_ENTER
+#define STAT_LEAVE(ker)
+
+#endif
+
+void STATS_GET(long * __restrict__ cnt, double * __restrict__ sec, double * __restrict__ busy,
+               long * __restrict__ nTask) {
+#if MATOP_STATS
+    memcpy(cnt, statCnt, sizeof(statCnt));
+    memcpy(sec, statSec, sizeof(statSec));
+    *busy = (double)__atomic_load_n(&statBusyNs, __ATOMIC_RELAXED) * 1e-9;
+    *nTask = __atomic_load_n(&statTask, __ATOMIC_RELAXED);
+#else
+    memset(cnt, 0, ST_NKER * sizeof(long));
+    memset(sec, 0, ST_NKER * sizeof(double));
+    *busy = 0;
+    *nTask = 0;
+#endif
+
+    return;
+}
+
+void STATS_RESET(void) {
+#if MATOP_STATS
+    memset(statCnt, 0, sizeof(statCnt));
+    memset(statSec, 0, sizeof(statSec));
+    __atomic_store_n(&statBusyNs, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&statTask, 0, __ATOMIC_RELAXED);
+#endif
+
+    return;
+}
+
+/*
+ * Per-thread scratch arena.
+ *
+ * Each worker owns one aligned slab and hands out tile buffers by pointer bump,
+ * so task kernels get their temporaries without touching the allocator.
+ * The slab is reset after every task; it grows (while empty) to the largest demand seen,
+ * and requests that cannot fit next to live data fall back to one-off allocations
+ * which are collected at the next reset.
+ */
+static __thread char *arenaBase = NULL;
+static __thread size_t arenaSz = 0;
+static __thread size_t arenaOff = 0;
+static __thread void **arenaOvf = NULL;
+static __thread int arenaOvfCnt = 0;
+static __thread int arenaOvfCap = 0;
+
+static void *__ARENAAlloc(size_t sz) {
+    sz = (sz + 31) & ~(size_t)31;
+
+    if (arenaOff + sz > arenaSz) {
+        if (arenaOff == 0) {
+            free(arenaBase);
+            arenaSz = arenaSz * 2 > sz ? arenaSz * 2 : sz;
+            arenaBase = (char *)aligned_alloc(32, arenaSz);
+        } else {
+            if (arenaOvfCnt == arenaOvfCap) {
+                arenaOvfCap = arenaOvfCap == 0 ? 4 : arenaOvfCap * 2;
+                arenaOvf = (void **)realloc(arenaOvf, arenaOvfCap * sizeof(void *));
+            }
+
+            arenaOvf[arenaOvfCnt] = aligned_alloc(32, sz);
+
+            return arenaOvf[arenaOvfCnt++];
+        }
+    }
+
+    void *p = arenaBase + arenaOff;
+    arenaOff += sz;
+
+    return p;
+}
+
+static void __ARENAReset(void) {
+    arenaOff = 0;
+
+    for (int i = 0; i < arenaOvfCnt; i++) {
+        free(arenaOvf[i]);
+    }
+
+    arenaOvfCnt = 0;
+
+    return;
+}
+
+/*
+ * Claims one task for worker self: its own deque from the front, then the others from the back.
+ * The caller must have claimed a slot through taskAvail beforehand, so a task exists somewhere;
+ * a scan can still come back empty when a racing claimant popped "our" task from a deque
+ * we had already passed, in which case the worker loop simply rescans.
+ */
+static Task *__POOLClaim(int self) {
+    Task *task;
+
+    for (int k = 0; k < poolSz; k++) {
+        WkQ *q = &poolQ[(self + k) % poolSz];
+
+        pthread_mutex_lock(&q->mtx);
+
+        task = k == 0 ? q->head : q->tail;
+
+        if (task != NULL) {
+            if (task->prev == NULL) {
+                q->head = task->next;
+            } else {
+                task->prev->next = task->next;
+            }
+
+            if (task->next == NULL) {
+                q->tail = task->prev;
+            } else {
+                task->next->prev = task->prev;
+            }
+        }
+
+        pthread_mutex_unlock(&q->mtx);
+
+        if (task != NULL) {
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+static void *__POOLRun(void *arg) {
+    int self = (int)(long)arg;
+    Task *task;
+
+    /* Pin to a core before doing anything that faults in thread-local memory;
+     * refer to the pool comments above. */
+    cpu_set_t cpu;
+    long nCpu = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (nCpu > 0) {
+        CPU_ZERO(&cpu);
+        CPU_SET(self % (int)nCpu, &cpu);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu), &cpu);
+    }
+
+    while (TRUE) {
+        pthread_mutex_lock(&poolMutex);
+
+        while (taskAvail == 0) {
+            pthread_cond_wait(&taskCond, &poolMutex);
+        }
+
+        taskAvail--;
+        pthread_mutex_unlock(&poolMutex);
+
+        while ((task = __POOLClaim(self)) == NULL) {
+            sched_yield();
+        }
+
+#if MATOP_STATS
+        double busyT0 = __StatTick();
+#endif
+
+        task->run(task->arg);
+
+#if MATOP_STATS
+        __atomic_fetch_add(&statBusyNs, (long)((__StatTick() - busyT0) * 1e9), __ATOMIC_RELAXED);
+        __atomic_fetch_add(&statTask, 1, __ATOMIC_RELAXED);
+#endif
+
+        __ARENAReset();
+        free(task);
+        pthread_mutex_lock(&poolMutex);
+
+        if (--taskPend == 0) {
+            pthread_cond_broadcast(&doneCond);
+        }
+
+        pthread_mutex_unlock(&poolMutex);
+    }
+
+    return NULL;
+}
+
+void POOL_INIT(int nWorker) {
+    if (poolSz > 0) {
+        return;
+    }
+
+    if (nWorker <= 0) {
+        nWorker = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        nWorker = nWorker > 0 ? nWorker : 1;
+    }
+
+    poolWorker = (pthread_t *)malloc(nWorker * sizeof(pthread_t));
+    poolQ = (WkQ *)malloc(nWorker * sizeof(WkQ));
+
+    for (int i = 0; i < nWorker; i++) {
+        poolQ[i].head = poolQ[i].tail = NULL;
+        pthread_mutex_init(&poolQ[i].mtx, NULL);
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    /* Resolve the ISA check once here, before the workers can race on its cached result. */
+    __SIMDOk();
+#endif
+
+    /* poolSz must be visible before the workers scan the deques. */
+    poolSz = nWorker;
+
+    for (int i = 0; i < nWorker; i++) {
+        pthread_create(&poolWorker[i], NULL, __POOLRun, (void *)(long)i);
+    }
+
+    return;
+}
+
+static void __POOLSubmit(void *(*run)(void *), void *arg) {
+    Task *task = (Task *)malloc(sizeof(Task));
+    WkQ *q;
+
+    task->run = run;
+    task->arg = arg;
+    task->next = NULL;
+
+    /* Deal round-robin; the submitting thread is the only one pushing, so poolRR needs no lock. */
+    q = &poolQ[poolRR++ % poolSz];
+
+    pthread_mutex_lock(&q->mtx);
+
+    task->prev = q->tail;
+
+    if (q->tail == NULL) {
+        q->head = q->tail = task;
+    } else {
+        q->tail->next = task;
+        q->tail = task;
+    }
+
+    pthread_mutex_unlock(&q->mtx);
+    pthread_mutex_lock(&poolMutex);
+
+    taskPend++;
+    taskAvail++;
+    pthread_cond_signal(&taskCond);
+    pthread_mutex_unlock(&poolMutex);
+
+    return;
+}
+
+static void __POOLWait(void) {
+    pthread_mutex_lock(&poolMutex);
+
+    while (taskPend > 0) {
+        pthread_cond_wait(&doneCond, &poolMutex);
+    }
+
+    pthread_mutex_unlock(&poolMutex);
+
+    return;
+}
+
+void *__GEMMI(void *arg);
+void *__GEMMF(void *arg);
+void *__GEMMI32(void *arg);
+void *__GEMMF32(void *arg);
+void GEMM(const void * __restrict__ A, const void * __restrict__ B, void * __restrict__ C, int l, int m, int n,
+          int ldA, int ldB, int ldC, int blkSz, int dt);
+
+void GEMM_BATCH(const void ** __restrict__ A, const void ** __restrict__ B, void ** __restrict__ C,
+                const int * __restrict__ l, const int * __restrict__ m, const int * __restrict__ n, int cnt, int dt);
+
+void GEMM_STRA(const double * __restrict__ A, const double * __restrict__ B, double * __restrict__ C,
+               int l, int m, int n, int ldA, int ldB, int ldC, int blkSz);
+
+void *__SYRKF(void *arg);
+void SYRK(const double * __restrict__ A, double * __restrict__ C, int m, int n, int ldA, int ldC, int blkSz);
+
+void __LUPP(double * __restrict__ A, int * __restrict__ p, int * __restrict__ flag, int m, int n, int ld, double tol);
+void __LUCP(double * __restrict__ A, int * __restrict__ p, int * __restrict__ q, int * __restrict__ flag,
+            int m, int n, int ld, double tol);
+void LU(double * __restrict__ A, int * __restrict__ p, int * __restrict__ q, int * __restrict__ flag,
+        int m, int n, int ld, _Bool cp, double tol);
+
+void *__SYRKFSub(void *arg);
+void *__SYRKFSubDiag(void *arg);
+void *__CHOLSlv(void *arg);
+void CHOL(double * __restrict__ A, int * __restrict__ flag, int n, int ld, double tol);
+
+void *__TRSML(void *arg);
+void *__TRSMU(void *arg);
+void TRSM(const double * __restrict__ A, double * __restrict__ B, int n, int nrhs, int ldA, int ldB,
+          _Bool lower, _Bool unit, int blkSz);
+void SOLVE(double * __restrict__ A, double * __restrict__ B, int * __restrict__ flag, int n, int nrhs,
+           int ldA, int ldB, double tol);
+void DET(double * __restrict__ A, double * __restrict__ det, int * __restrict__ flag, int n, int ld, double tol);
+
+void *__EWISEF(void *arg);
+void *__EWISEI(void *arg);
+void EWISE(const void * __restrict__ A, const void * __restrict__ B, void * __restrict__ C, long n, int op, int dt,
+           int bcast);
+
+void *__EWFUSEF(void *arg);
+void *__EWFUSEI(void *arg);
+void EWFUSE(const void * const * __restrict__ opnd, const long * __restrict__ prog, long nProg,
+            void * __restrict__ C, long n, int dt);
+
+void *__REDUCEF(void *arg);
+void *__REDUCEI(void *arg);
+void REDUCE(const void * __restrict__ A, const void * __restrict__ B, void * __restrict__ res,
+            long * __restrict__ idx, long n, int op, int dt);
+
+void *__TRANSF(void *arg);
+void *__TRANSI(void *arg);
+void TRANS(const void * __restrict__ A, void * __restrict__ B, long m, long n, int dt);
+void INV(double * __restrict__ A, double * __restrict__ B, int * __restrict__ flag, int n, int ldA, int ldB,
+         double tol);
+
+void QR(double * __restrict__ A, double * __restrict__ v, int * __restrict__ flag, int m, int n, int ld, double tol);
+
+void *__GEMMI(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const long * __restrict__ A = (const long *)data->A;
+    const long * __restrict__ B = (const long *)data->B;
+    long * __restrict__ C = (long *)data->C;
+    int * __restrict__ dim = data->dim;
+    int * __restrict__ ld = data->ld;
+
+    for (int i = 0; i < dim[0]; i++) {
+        for (int k = 0; k < dim[1]; k++) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[i * ld[2] + j] += A[i * ld[0] + k] * B[k * ld[1] + j];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/*
+ * The packed microkernels below carry their own target attributes,
+ * so they compile for AVX2+FMA while the rest of this translation unit (and the default build)
+ * stays plain x86-64 and the shared object loads on machines without AVX2.
+ * Whether they may actually RUN is decided once at runtime by __SIMDOk;
+ * the plain loops of __GEMMF and __GEMMF32 remain as the portable path.
+ */
+static int __SIMDOk(void) {
+    static int ok = -1;
+
+    if (ok < 0) {
+        ok = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    }
+
+    return ok;
+}
+
+/*
+ * Computes one MR by NR register tile of C over kc inner-product steps.
+ * Operands come packed: a holds MR consecutive rows of A in column-major panels (MR entries per step),
+ * b holds NR consecutive columns of B in row-major panels (NR entries per step).
+ * All FLOPs run on eight FMA accumulators which stay in registers for the whole k loop.
+ */
+__attribute__((target("avx2,fma")))
+static void __GEMMFMicro(const double * __restrict__ a, const double * __restrict__ b, double * __restrict__ c,
+                         int kc, int ldC) {
+    __m256d acc[MR][2];
+
+    for (int i = 0; i < MR; i++) {
+        acc[i][0] = _mm256_loadu_pd(c + i * ldC);
+        acc[i][1] = _mm256_loadu_pd(c + i * ldC + 4);
+    }
+
+    for (int k = 0; k < kc; k++) {
+        __m256d b0 = _mm256_load_pd(b + k * NR);
+        __m256d b1 = _mm256_load_pd(b + k * NR + 4);
+
+        for (int i = 0; i < MR; i++) {
+            __m256d ai = _mm256_broadcast_sd(a + k * MR + i);
+
+            acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+        }
+    }
+
+    for (int i = 0; i < MR; i++) {
+        _mm256_storeu_pd(c + i * ldC, acc[i][0]);
+        _mm256_storeu_pd(c + i * ldC + 4, acc[i][1]);
+    }
+
+    return;
+}
+
+/*
+ * Register-blocked update of one C tile: packs A and B panels into aligned contiguous scratch
+ * and sweeps the tile with the MR by NR microkernel.
+ * Rows and columns which do not fill a whole register tile are finished by the scalar loop below.
+ */
+__attribute__((target("avx2,fma")))
+static void __GEMMFPacked(const double * __restrict__ A, const double * __restrict__ B, double * __restrict__ C,
+                          const int * __restrict__ dim, const int * __restrict__ ld) {
+    int mr = dim[0] - dim[0] % MR;
+    int nr = dim[2] - dim[2] % NR;
+    double * __restrict__ aPack = (double *)__ARENAAlloc(KC * MR * sizeof(double));
+    double * __restrict__ bPack = (double *)__ARENAAlloc((size_t)KC * nr * sizeof(double));
+
+    for (int kk = 0; kk < dim[1]; kk += KC) {
+        int kc = MIN(KC, dim[1] - kk);
+
+        for (int jj = 0; jj < nr; jj += NR) {
+            double * __restrict__ bPanel = bPack + (size_t)(jj / NR) * kc * NR;
+
+            for (int k = 0; k < kc; k++) {
+                for (int j = 0; j < NR; j++) {
+                    bPanel[k * NR + j] = B[(kk + k) * ld[1] + jj + j];
+                }
+            }
+        }
+
+        for (int ii = 0; ii < mr; ii += MR) {
+            for (int k = 0; k < kc; k++) {
+                for (int i = 0; i < MR; i++) {
+                    aPack[k * MR + i] = A[(ii + i) * ld[0] + kk + k];
+                }
+            }
+
+            for (int jj = 0; jj < nr; jj += NR) {
+                __GEMMFMicro(aPack, bPack + (size_t)(jj / NR) * kc * NR, C + ii * ld[2] + jj, kc, ld[2]);
+            }
+        }
+    }
+
+    for (int i = mr; i < dim[0]; i++) {
+        for (int k = 0; k < dim[1]; k++) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[i * ld[2] + j] += A[i * ld[0] + k] * B[k * ld[1] + j];
+            }
+        }
+    }
+
+    for (int i = 0; i < mr; i++) {
+        for (int k = 0; k < dim[1]; k++) {
+            for (int j = nr; j < dim[2]; j++) {
+                C[i * ld[2] + j] += A[i * ld[0] + k] * B[k * ld[1] + j];
+            }
+        }
+    }
+
+    return;
+}
+
+/*
+ * Single-precision twin of __GEMMFMicro: MR by 2*NR floats per register tile,
+ * twice the elements per vector at the same register budget.
+ */
+__attribute__((target("avx2,fma")))
+static void __GEMMF32Micro(const float * __restrict__ a, const float * __restrict__ b, float * __restrict__ c,
+                           int kc, int ldC) {
+    __m256 acc[MR][2];
+
+    for (int i = 0; i < MR; i++) {
+        acc[i][0] = _mm256_loadu_ps(c + i * ldC);
+        acc[i][1] = _mm256_loadu_ps(c + i * ldC + 8);
+    }
+
+    for (int k = 0; k < kc; k++) {
+        __m256 b0 = _mm256_load_ps(b + k * 2 * NR);
+        __m256 b1 = _mm256_load_ps(b + k * 2 * NR + 8);
+
+        for (int i = 0; i < MR; i++) {
+            __m256 ai = _mm256_broadcast_ss(a + k * MR + i);
+
+            acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+        }
+    }
+
+    for (int i = 0; i < MR; i++) {
+        _mm256_storeu_ps(c + i * ldC, acc[i][0]);
+        _mm256_storeu_ps(c + i * ldC + 8, acc[i][1]);
+    }
+
+    return;
+}
+
+/* Refer to the comments of __GEMMFPacked. Panels here are 2*NR floats wide. */
+__attribute__((target("avx2,fma")))
+static void __GEMMF32Packed(const float * __restrict__ A, const float * __restrict__ B, float * __restrict__ C,
+                            const int * __restrict__ dim, const int * __restrict__ ld) {
+    int nrw = 2 * NR;
+    int mr = dim[0] - dim[0] % MR;
+    int nr = dim[2] - dim[2] % nrw;
+    float * __restrict__ aPack = (float *)__ARENAAlloc(KC * MR * sizeof(float));
+    float * __restrict__ bPack = (float *)__ARENAAlloc((size_t)KC * nr * sizeof(float));
+
+    for (int kk = 0; kk < dim[1]; kk += KC) {
+        int kc = MIN(KC, dim[1] - kk);
+
+        for (int jj = 0; jj < nr; jj += nrw) {
+            float * __restrict__ bPanel = bPack + (size_t)(jj / nrw) * kc * nrw;
+
+            for (int k = 0; k < kc; k++) {
+                for (int j = 0; j < nrw; j++) {
+                    bPanel[k * nrw + j] = B[(kk + k) * ld[1] + jj + j];
+                }
+            }
+        }
+
+        for (int ii = 0; ii < mr; ii += MR) {
+            for (int k = 0; k < kc; k++) {
+                for (int i = 0; i < MR; i++) {
+                    aPack[k * MR + i] = A[(ii + i) * ld[0] + kk + k];
+                }
+            }
+
+            for (int jj = 0; jj < nr; jj += nrw) {
+                __GEMMF32Micro(aPack, bPack + (size_t)(jj / nrw) * kc * nrw, C + ii * ld[2] + jj, kc, ld[2]);
+            }
+        }
+    }
+
+    for (int i = mr; i < dim[0]; i++) {
+        for (int k = 0; k < dim[1]; k++) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[i * ld[2] + j] += A[i * ld[0] + k] * B[k * ld[1] + j];
+            }
+        }
+    }
+
+    for (int i = 0; i < mr; i++) {
+        for (int k = 0; k < dim[1]; k++) {
+            for (int j = nr; j < dim[2]; j++) {
+                C[i * ld[2] + j] += A[i * ld[0] + k] * B[k * ld[1] + j];
+            }
+        }
+    }
+
+    return;
+}
+
+#endif
+
+void *__GEMMF(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const double * __restrict__ A = (const double *)data->A;
+    const double * __restrict__ B = (const double *)data->B;
+    double * __restrict__ C = (double *)data->C;
+    int * __restrict__ dim = data->dim;
+    int * __restrict__ ld = data->ld;
+
+#if defined(__x86_64__) || defined(__i386__)
+    if (__SIMDOk() && dim[0] >= MR && dim[1] >= MICRO_MIN && dim[2] >= NR) {
+        __GEMMFPacked(A, B, C, dim, ld);
+
+        return NULL;
+    }
+#endif
+
+    for (int i = 0; i < dim[0]; i++) {
+        for (int k = 0; k < dim[1]; k++) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[i * ld[2] + j] += A[i * ld[0] + k] * B[k * ld[1] + j];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void *__GEMMI32(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const int * __restrict__ A = (const int *)data->A;
+    const int * __restrict__ B = (const int *)data->B;
+    int * __restrict__ C = (int *)data->C;
+    int * __restrict__ dim = data->dim;
+    int * __restrict__ ld = data->ld;
+
+    for (int i = 0; i < dim[0]; i++) {
+        for (int k = 0; k < dim[1]; k++) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[i * ld[2] + j] += A[i * ld[0] + k] * B[k * ld[1] + j];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void *__GEMMF32(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const float * __restrict__ A = (const float *)data->A;
+    const float * __restrict__ B = (const float *)data->B;
+    float * __restrict__ C = (float *)data->C;
+    int * __restrict__ dim = data->dim;
+    int * __restrict__ ld = data->ld;
+
+#if defined(__x86_64__) || defined(__i386__)
+    if (__SIMDOk() && dim[0] >= MR && dim[1] >= MICRO_MIN && dim[2] >= 2 * NR) {
+        __GEMMF32Packed(A, B, C, dim, ld);
+
+        return NULL;
+    }
+#endif
+
+    for (int i = 0; i < dim[0]; i++) {
+        for (int k = 0; k < dim[1]; k++) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[i * ld[2] + j] += A[i * ld[0] + k] * B[k * ld[1] + j];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Each task owns one disjoint tile of the output C and runs the whole inner-product dimension locally.
+ * No two tasks ever write the same element of C, so write-back needs neither a mutex
+ * nor a per-block accumulation buffer.
+ */
+void GEMM(const void * __restrict__ A, const void * __restrict__ B, void * __restrict__ C, int l, int m, int n,
+          int ldA, int ldB, int ldC, int blkSz, int dt) {
+    STAT_ENTER;
+
+    int lBlk = (l - 1) / blkSz + 1;
+    int nBlk = (n - 1) / blkSz + 1;
+    int elemSz = (dt == DT_INT32 || dt == DT_FLT32) ? 4 : 8;
+    void *(*kernel)(void *) = dt == DT_LONG ? __GEMMI
+                            : dt == DT_DOUBLE ? __GEMMF
+                            : dt == DT_INT32 ? __GEMMI32 : __GEMMF32;
+
+    POOL_INIT(0);
+    Data * __restrict__ data = (Data *)malloc(lBlk * nBlk * sizeof(Data));
+    int cnt = 0;
+
+    for (int i = 0; i < lBlk; i++) {
+        for (int k = 0; k < nBlk; k++) {
+            data[cnt].A = (const char *)A + (size_t)i * blkSz * ldA * elemSz;
+            data[cnt].B = (const char *)B + (size_t)k * blkSz * elemSz;
+            data[cnt].C = (char *)C + ((size_t)i * blkSz * ldC + (size_t)k * blkSz) * elemSz;
+            data[cnt].dim[0] = MIN(blkSz, l - blkSz * i);
+            data[cnt].dim[1] = m;
+            data[cnt].dim[2] = MIN(blkSz, n - blkSz * k);
+            data[cnt].ld[0] = ldA;
+            data[cnt].ld[1] = ldB;
+            data[cnt].ld[2] = ldC;
+
+            __POOLSubmit(kernel, &data[cnt]);
+            cnt++;
+        }
+    }
+
+    __POOLWait();
+    free(data);
+
+    STAT_LEAVE(ST_GEMM);
+
+    return;
+}
+
+static void __STRACmb(const double * __restrict__ X, const double * __restrict__ Y, double * __restrict__ T,
+                      int r, int c, int ldX, int ldY, int sign) {
+    for (int i = 0; i < r; i++) {
+        for (int j = 0; j < c; j++) {
+            T[i * c + j] = X[i * ldX + j] + sign * Y[i * ldY + j];
+        }
+    }
+
+    return;
+}
+
+static void __STRAAcc(double * __restrict__ C, const double * __restrict__ P, int r, int c, int ldC, int sign) {
+    for (int i = 0; i < r; i++) {
+        for (int j = 0; j < c; j++) {
+            C[i * ldC + j] += sign * P[i * c + j];
+        }
+    }
+
+    return;
+}
+
+static void __STRAF(const double * __restrict__ A, const double * __restrict__ B, double * __restrict__ C,
+                    int l, int m, int n, int ldA, int ldB, int ldC, int blkSz) {
+    if ((l % 2 | m % 2 | n % 2) || MIN(MIN(l, m), n) < 2 * STRA_MIN) {
+        GEMM(A, B, C, l, m, n, ldA, ldB, ldC, blkSz, DT_DOUBLE);
+
+        return;
+    }
+
+    int l2 = l / 2, m2 = m / 2, n2 = n / 2;
+    const double *A11 = A, *A12 = A + m2, *A21 = A + (size_t)l2 * ldA, *A22 = A21 + m2;
+    const double *B11 = B, *B12 = B + n2, *B21 = B + (size_t)m2 * ldB, *B22 = B21 + n2;
+    double *C11 = C, *C12 = C + n2, *C21 = C + (size_t)l2 * ldC, *C22 = C21 + n2;
+    double * __restrict__ T1 = (double *)malloc((size_t)l2 * m2 * sizeof(double));
+    double * __restrict__ T2 = (double *)malloc((size_t)m2 * n2 * sizeof(double));
+    double * __restrict__ P = (double *)malloc((size_t)l2 * n2 * sizeof(double));
+
+    /* M1 = (A11 + A22)(B11 + B22), contributes to C11 and C22. */
+    __STRACmb(A11, A22, T1, l2, m2, ldA, ldA, 1);
+    __STRACmb(B11, B22, T2, m2, n2, ldB, ldB, 1);
+
+    for (int i = 0; i < l2 * n2; i++) {
+        P[i] = 0;
+    }
+
+    __STRAF(T1, T2, P, l2, m2, n2, m2, n2, n2, blkSz);
+    __STRAAcc(C11, P, l2, n2, ldC, 1);
+    __STRAAcc(C22, P, l2, n2, ldC, 1);
+
+    /* M2 = (A21 + A22) B11, contributes to C21 and C22. */
+    __STRACmb(A21, A22, T1, l2, m2, ldA, ldA, 1);
+    __STRACmb(B11, B11, T2, m2, n2, ldB, ldB, 0);
+
+    for (int i = 0; i < l2 * n2; i++) {
+        P[i] = 0;
+    }
+
+    __STRAF(T1, T2, P, l2, m2, n2, m2, n2, n2, blkSz);
+    __STRAAcc(C21, P, l2, n2, ldC, 1);
+    __STRAAcc(C22, P, l2, n2, ldC, -1);
+
+    /* M3 = A11 (B12 - B22), contributes to C12 and C22. */
+    __STRACmb(A11, A11, T1, l2, m2, ldA, ldA, 0);
+    __STRACmb(B12, B22, T2, m2, n2, ldB, ldB, -1);
+
+    for (int i = 0; i < l2 * n2; i++) {
+        P[i] = 0;
+    }
+
+    __STRAF(T1, T2, P, l2, m2, n2, m2, n2, n2, blkSz);
+    __STRAAcc(C12, P, l2, n2, ldC, 1);
+    __STRAAcc(C22, P, l2, n2, ldC, 1);
+
+    /* M4 = A22 (B21 - B11), contributes to C11 and C21. */
+    __STRACmb(A22, A22, T1, l2, m2, ldA, ldA, 0);
+    __STRACmb(B21, B11, T2, m2, n2, ldB, ldB, -1);
+
+    for (int i = 0; i < l2 * n2; i++) {
+        P[i] = 0;
+    }
+
+    __STRAF(T1, T2, P, l2, m2, n2, m2, n2, n2, blkSz);
+    __STRAAcc(C11, P, l2, n2, ldC, 1);
+    __STRAAcc(C21, P, l2, n2, ldC, 1);
+
+    /* M5 = (A11 + A12) B22, contributes to C11 and C12. */
+    __STRACmb(A11, A12, T1, l2, m2, ldA, ldA, 1);
+    __STRACmb(B22, B22, T2, m2, n2, ldB, ldB, 0);
+
+    for (int i = 0; i < l2 * n2; i++) {
+        P[i] = 0;
+    }
+
+    __STRAF(T1, T2, P, l2, m2, n2, m2, n2, n2, blkSz);
+    __STRAAcc(C11, P, l2, n2, ldC, -1);
+    __STRAAcc(C12, P, l2, n2, ldC, 1);
+
+    /* M6 = (A21 - A11)(B11 + B12), contributes to C22. */
+    __STRACmb(A21, A11, T1, l2, m2, ldA, ldA, -1);
+    __STRACmb(B11, B12, T2, m2, n2, ldB, ldB, 1);
+
+    for (int i = 0; i < l2 * n2; i++) {
+        P[i] = 0;
+    }
+
+    __STRAF(T1, T2, P, l2, m2, n2, m2, n2, n2, blkSz);
+    __STRAAcc(C22, P, l2, n2, ldC, 1);
+
+    /* M7 = (A12 - A22)(B21 + B22), contributes to C11. */
+    __STRACmb(A12, A22, T1, l2, m2, ldA, ldA, -1);
+    __STRACmb(B21, B22, T2, m2, n2, ldB, ldB, 1);
+
+    for (int i = 0; i < l2 * n2; i++) {
+        P[i] = 0;
+    }
+
+    __STRAF(T1, T2, P, l2, m2, n2, m2, n2, n2, blkSz);
+    __STRAAcc(C11, P, l2, n2, ldC, 1);
+
+    free(T1);
+    free(T2);
+    free(P);
+
+    return;
+}
+
+/*
+ * Batched multiplication: one task per product, the whole batch fanned across the pool in a single call.
+ * Matrices in the batch are expected to be small, so tiling individual products would only add overhead;
+ * instead each worker runs one complete multiply.
+ * All buffers are tightly packed flat matrices, ie. leading dimension equals # of columns.
+ */
+void GEMM_BATCH(const void ** __restrict__ A, const void ** __restrict__ B, void ** __restrict__ C,
+                const int * __restrict__ l, const int * __restrict__ m, const int * __restrict__ n, int cnt, int dt) {
+    STAT_ENTER;
+
+    void *(*kernel)(void *) = dt == DT_LONG ? __GEMMI
+                            : dt == DT_DOUBLE ? __GEMMF
+                            : dt == DT_INT32 ? __GEMMI32 : __GEMMF32;
+
+    POOL_INIT(0);
+    Data * __restrict__ data = (Data *)malloc(cnt * sizeof(Data));
+
+    for (int i = 0; i < cnt; i++) {
+        data[i].A = A[i];
+        data[i].B = B[i];
+        data[i].C = C[i];
+        data[i].dim[0] = l[i];
+        data[i].dim[1] = m[i];
+        data[i].dim[2] = n[i];
+        data[i].ld[0] = m[i];
+        data[i].ld[1] = n[i];
+        data[i].ld[2] = n[i];
+
+        __POOLSubmit(kernel, &data[i]);
+    }
+
+    __POOLWait();
+    free(data);
+
+    STAT_LEAVE(ST_GEMM_BATCH);
+
+    return;
+}
+
+/*
+ * Strassen multiplication for large double matrices.
+ * Recursion halves all three extents; once a sub-block falls under the cutoff (or an extent turns odd),
+ * the blocked GEMM kernels take over, so small-matrix latency is untouched.
+ */
+void GEMM_STRA(const double * __restrict__ A, const double * __restrict__ B, double * __restrict__ C,
+               int l, int m, int n, int ldA, int ldB, int ldC, int blkSz) {
+    STAT_ENTER;
+
+    __STRAF(A, B, C, l, m, n, ldA, ldB, ldC, blkSz);
+
+    STAT_LEAVE(ST_GEMM_STRA);
+
+    return;
+}
+
+/*
+ * One upper-triangle tile of C = A'A.
+ * Operand pointers are offset to the first involved column of A: A runs over the tile's rows of C,
+ * B over its columns. dim[1] is the full # of rows of A.
+ */
+void *__SYRKF(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const double * __restrict__ A = (const double *)data->A;
+    const double * __restrict__ B = (const double *)data->B;
+    double * __restrict__ C = (double *)data->C;
+    int * __restrict__ dim = data->dim;
+    int * __restrict__ ld = data->ld;
+
+    for (int k = 0; k < dim[1]; k++) {
+        for (int i = 0; i < dim[0]; i++) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[i * ld[2] + j] += A[k * ld[0] + i] * B[k * ld[1] + j];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Symmetric crossproduct C = A'A for m by n matrix A.
+ * Only tiles on or above the diagonal of C are computed; the strict lower triangle is mirrored afterwards.
+ * This halves both FLOPs and the tile count compared to routing t(A) through GEMM.
+ */
+void SYRK(const double * __restrict__ A, double * __restrict__ C, int m, int n, int ldA, int ldC, int blkSz) {
+    STAT_ENTER;
+
+    int nBlk = (n - 1) / blkSz + 1;
+
+    POOL_INIT(0);
+    Data * __restrict__ data = (Data *)malloc(nBlk * (nBlk + 1) / 2 * sizeof(Data));
+    int cnt = 0;
+
+    for (int i = 0; i < nBlk; i++) {
+        for (int j = i; j < nBlk; j++) {
+            data[cnt].A = A + i * blkSz;
+            data[cnt].B = A + j * blkSz;
+            data[cnt].C = C + (size_t)i * blkSz * ldC + j * blkSz;
+            data[cnt].dim[0] = MIN(blkSz, n - blkSz * i);
+            data[cnt].dim[1] = m;
+            data[cnt].dim[2] = MIN(blkSz, n - blkSz * j);
+            data[cnt].ld[0] = ldA;
+            data[cnt].ld[1] = ldA;
+            data[cnt].ld[2] = ldC;
+
+            __POOLSubmit(__SYRKF, &data[cnt]);
+            cnt++;
+        }
+    }
+
+    __POOLWait();
+    free(data);
+
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            C[j * ldC + i] = C[i * ldC + j];
+        }
+    }
+
+    STAT_LEAVE(ST_SYRK);
+
+    return;
+}
+
+/*
+ * Unblocked factorization of one panel: columns i0 .. i0 + nb - 1, rows i0 .. m - 1.
+ * Pivot rows are swapped across the full width of A and recorded in p.
+ * Eliminations stay inside the panel; everything right of it is handled by the caller
+ * with a triangular solve and a GEMM trailing update.
+ * On a zero pivot, *flag is set to the offending global column; otherwise it is left untouched.
+ */
+static void __LUPanel(double * __restrict__ A, int * __restrict__ p, int * __restrict__ flag,
+                      int m, int n, int ld, int i0, int nb, double tol) {
+    int pv, pv_tmp;
+    double tmp;
+    int l = MIN(m, n);
+
+    for (int i = i0; i < i0 + nb; i++) {
+        if (i >= l - 1) {
+            break;
+        }
+
+        pv = i;
+
+        for (int j = i + 1; j < m; j++) {
+            if (fabs(A[pv * ld + i]) < fabs(A[j * ld + i])) {
+                pv = j;
+            }
+        }
+
+        if (pv != i) {
+            pv_tmp = p[pv];
+            p[pv] = p[i];
+            p[i] = pv_tmp;
+
+            for (int k = 0; k < n; k++) {
+                tmp = A[pv * ld + k];
+                A[pv * ld + k] = A[i * ld + k];
+                A[i * ld + k] = tmp;
+            }
+        }
+
+        if (fabs(A[i * ld + i]) < tol) {
+            *flag = i;
+
+            return;
+        }
+
+        for (int j = i + 1; j < m; j++) {
+            A[j * ld + i] /= A[i * ld + i];
+
+            for (int k = i + 1; k < i0 + nb; k++) {
+                A[j * ld + k] -= A[j * ld + i] * A[i * ld + k];
+            }
+        }
+    }
+
+    return;
+}
+
+/*
+ * Right-looking panel LU with partial pivoting.
+ * Each round factors one narrow panel with the unblocked code above, solves the unit lower triangular
+ * system for the U block right of the panel, and applies the rank-nb trailing update through GEMM,
+ * so the cubic bulk of the work runs at matrix-multiply speed on the worker pool.
+ * GEMM accumulates with a plus sign, so the U block is negated around the call to get the subtraction.
+ */
+void __LUPP(double * __restrict__ A, int * __restrict__ p, int * __restrict__ flag, int m, int n, int ld, double tol) {
+    int l = MIN(m, n);
+
+    for (int i0 = 0; i0 < l; i0 += PANEL_NB) {
+        int nb = MIN(PANEL_NB, l - i0);
+
+        *flag = -1;
+        __LUPanel(A, p, flag, m, n, ld, i0, nb, tol);
+
+        if (*flag >= 0) {
+            return;
+        }
+
+        if (i0 + nb < n) {
+            for (int k = i0; k < i0 + nb; k++) {
+                for (int i = k + 1; i < i0 + nb; i++) {
+                    for (int j = i0 + nb; j < n; j++) {
+                        A[i * ld + j] -= A[i * ld + k] * A[k * ld + j];
+                    }
+                }
+            }
+        }
+
+        if (i0 + nb < m && i0 + nb < n) {
+            for (int i = i0; i < i0 + nb; i++) {
+                for (int j = i0 + nb; j < n; j++) {
+                    A[i * ld + j] = -A[i * ld + j];
+                }
+            }
+
+            GEMM(A + (size_t)(i0 + nb) * ld + i0, A + (size_t)i0 * ld + i0 + nb, A + (size_t)(i0 + nb) * ld + i0 + nb,
+                 m - i0 - nb, nb, n - i0 - nb, ld, ld, ld, tunePnl, DT_DOUBLE);
+
+            for (int i = i0; i < i0 + nb; i++) {
+                for (int j = i0 + nb; j < n; j++) {
+                    A[i * ld + j] = -A[i * ld + j];
+                }
+            }
+        }
+    }
+
+    *flag = fabs(A[(l - 1) * ld + l - 1]) < tol ? (l - 1) : l;
+
+    return;
+}
+
+void __LUCP(double * __restrict__ A, int * __restrict__ p, int * __restrict__ q, int * __restrict__ flag,
+            int m, int n, int ld, double tol) {
+    int pv1, pv2, pv_tmp;
+    double tmp;
+    int l = MIN(m, n);
+
+    for (int i = 0; i < l - 1; i++) {
+        pv1 = pv2 = i;
+
+        for (int j = i; j < m; j++) {
+            for (int k = i; k < n; k++) {
+                if (fabs(A[pv1 * ld + pv2]) < fabs(A[j * ld + k])) {
+                    pv1 = j;
+                    pv2 = k;
+                }
+            }
+        }
+
+        if (pv1 != i) {
+            pv_tmp = p[pv1];
+            p[pv1] = p[i];
+            p[i] = pv_tmp;
+
+            for (int k = 0; k < n; k++) {
+                tmp = A[pv1 * ld + k];
+                A[pv1 * ld + k] = A[i * ld + k];
+                A[i * ld + k] = tmp;
+            }
+        }
+
+        if (pv2 != i) {
+            pv_tmp = q[pv2];
+            q[pv2] = q[i];
+            q[i] = pv_tmp;
+
+            for (int j = 0; j < m; j++) {
+                tmp = A[j * ld + i];
+                A[j * ld + i] = A[j * ld + pv2];
+                A[j * ld + pv2] = tmp;
+            }
+        }
+
+        if (fabs(A[i * ld + i]) < tol) {
+            *flag = i;
+
+            return;
+        }
+
+        for (int j = i + 1; j < m; j++) {
+            A[j * ld + i] /= A[i * ld + i];
+
+            for (int k = i + 1; k < n; k++) {
+                A[j * ld + k] -= A[j * ld + i] * A[i * ld + k];
+            }
+        }
+    }
+
+    *flag = fabs(A[(l - 1) * ld + l - 1]) < tol ? (l - 1) : l;
+
+    return;
+}
+
+void LU(double * __restrict__ A, int * __restrict__ p, int * __restrict__ q, int * __restrict__ flag,
+        int m, int n, int ld, _Bool cp, double tol) {
+    STAT_ENTER;
+
+    if (cp) {
+        __LUCP(A, p, q, flag, m, n, ld, tol);
+    } else {
+        __LUPP(A, p, flag, m, n, ld, tol);
+    }
+
+    STAT_LEAVE(ST_LU);
+
+    return;
+}
+
+/* Subtracting twin of __SYRKF: C -= A'B, used for the trailing update of the tiled Cholesky. */
+void *__SYRKFSub(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const double * __restrict__ A = (const double *)data->A;
+    const double * __restrict__ B = (const double *)data->B;
+    double * __restrict__ C = (double *)data->C;
+    int * __restrict__ dim = data->dim;
+    int * __restrict__ ld = data->ld;
+
+    for (int k = 0; k < dim[1]; k++) {
+        for (int i = 0; i < dim[0]; i++) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[i * ld[2] + j] -= A[k * ld[0] + i] * B[k * ld[1] + j];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Diagonal-tile twin of __SYRKFSub: the C tile sits on the diagonal of the trailing matrix,
+ * so only its entries on or above the diagonal are updated.  The strict lower half holds
+ * untouched input which chol hands back to the user in the compact output,
+ * exactly as the unblocked scalar loop left it.
+ */
+void *__SYRKFSubDiag(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const double * __restrict__ A = (const double *)data->A;
+    const double * __restrict__ B = (const double *)data->B;
+    double * __restrict__ C = (double *)data->C;
+    int * __restrict__ dim = data->dim;
+    int * __restrict__ ld = data->ld;
+
+    for (int k = 0; k < dim[1]; k++) {
+        for (int i = 0; i < dim[0]; i++) {
+            for (int j = i; j < dim[2]; j++) {
+                C[i * ld[2] + j] -= A[k * ld[0] + i] * B[k * ld[1] + j];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Panel-solve task of the tiled Cholesky: given the factored diagonal block R11 (upper triangular,
+ * A points at its top-left corner), forward-substitutes R11'X = C for one column tile of the panel in place.
+ */
+void *__CHOLSlv(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const double * __restrict__ R = (const double *)data->A;
+    double * __restrict__ C = (double *)data->C;
+    int * __restrict__ dim = data->dim;
+    int * __restrict__ ld = data->ld;
+
+    for (int k = 0; k < dim[0]; k++) {
+        for (int t = 0; t < k; t++) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[k * ld[2] + j] -= R[t * ld[0] + k] * C[t * ld[2] + j];
+            }
+        }
+
+        for (int j = 0; j < dim[2]; j++) {
+            C[k * ld[2] + j] /= R[k * ld[0] + k];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Unblocked factorization of one diagonal block of the tiled Cholesky.
+ * Works on the upper triangle of the nb by nb block at (i0, i0) only; columns right of the block
+ * are handled by the caller with a panel solve and a SYRK trailing update.
+ * On a nonpositive pivot, *flag is set to the offending global index; otherwise it is left untouched.
+ */
+static void __CHOLDiag(double * __restrict__ A, int * __restrict__ flag, int i0, int nb, int ld, double tol) {
+    double tmp;
+
+    for (int i = i0; i < i0 + nb; i++) {
+        if (A[i * ld + i] < tol) {
+            *flag = i;
+
+            return;
+        }
+
+        for (int j = i + 1; j < i0 + nb; j++) {
+            tmp = A[i * ld + j] / A[i * ld + i];
+
+            for (int k = j; k < i0 + nb; k++) {
+                A[j * ld + k] -= tmp * A[i * ld + k];
+            }
+        }
+
+        tmp = sqrt(A[i * ld + i]);
+
+        for (int j = i; j < i0 + nb; j++) {
+            A[i * ld + j] /= tmp;
+        }
+    }
+
+    return;
+}
+
+/*
+ * Tiled right-looking Cholesky, A = R'R with R kept in the upper triangle in place.
+ * Each round factors one diagonal block serially, then solves the panel row and applies the
+ * symmetric trailing update as independent tiles on the worker pool; only tiles on or above the
+ * diagonal of the trailing matrix are touched, and diagonal tiles update their upper half only,
+ * matching the upper-triangle-only output of the old scalar loop entry for entry.
+ * The flag early-exit semantics are unchanged.
+ */
+void CHOL(double * __restrict__ A, int * __restrict__ flag, int n, int ld, double tol) {
+    STAT_ENTER;
+
+    POOL_INIT(0);
+
+    for (int i0 = 0; i0 < n; i0 += PANEL_NB) {
+        int nb = MIN(PANEL_NB, n - i0);
+
+        *flag = -1;
+        __CHOLDiag(A, flag, i0, nb, ld, tol);
+
+        if (*flag >= 0) {
+            STAT_LEAVE(ST_CHOL);
+
+            return;
+        }
+
+        if (i0 + nb >= n) {
+            break;
+        }
+
+        int rem = n - i0 - nb;
+        int nBlk = (rem - 1) / tunePnl + 1;
+        Data * __restrict__ data = (Data *)malloc(nBlk * (nBlk + 1) / 2 * sizeof(Data));
+        int cnt = 0;
+
+        for (int j = 0; j < nBlk; j++) {
+            data[cnt].A = A + (size_t)i0 * ld + i0;
+            data[cnt].C = A + (size_t)i0 * ld + i0 + nb + j * tunePnl;
+            data[cnt].dim[0] = nb;
+            data[cnt].dim[2] = MIN(tunePnl, rem - j * tunePnl);
+            data[cnt].ld[0] = ld;
+            data[cnt].ld[2] = ld;
+
+            __POOLSubmit(__CHOLSlv, &data[cnt]);
+            cnt++;
+        }
+
+        __POOLWait();
+        cnt = 0;
+
+        for (int i = 0; i < nBlk; i++) {
+            for (int j = i; j < nBlk; j++) {
+                data[cnt].A = A + (size_t)i0 * ld + i0 + nb + i * tunePnl;
+                data[cnt].B = A + (size_t)i0 * ld + i0 + nb + j * tunePnl;
+                data[cnt].C = A + (size_t)(i0 + nb + i * tunePnl) * ld + i0 + nb + j * tunePnl;
+                data[cnt].dim[0] = MIN(tunePnl, rem - i * tunePnl);
+                data[cnt].dim[1] = nb;
+                data[cnt].dim[2] = MIN(tunePnl, rem - j * tunePnl);
+                data[cnt].ld[0] = ld;
+                data[cnt].ld[1] = ld;
+                data[cnt].ld[2] = ld;
+
+                __POOLSubmit(i == j ? __SYRKFSubDiag : __SYRKFSub, &data[cnt]);
+                cnt++;
+            }
+        }
+
+        __POOLWait();
+        free(data);
+    }
+
+    *flag = n;
+
+    STAT_LEAVE(ST_CHOL);
+
+    return;
+}
+
+/*
+ * Forward substitution task: solves LX = C in place for one column tile of the right hand side,
+ * where L is the lower triangle of A.  dim[1] flags a unit diagonal, in which case the stored
+ * diagonal entries are ignored.
+ */
+void *__TRSML(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const double * __restrict__ A = (const double *)data->A;
+    double * __restrict__ C = (double *)data->C;
+    int * __restrict__ dim = data->dim;
+    int * __restrict__ ld = data->ld;
+
+    for (int i = 0; i < dim[0]; i++) {
+        for (int k = 0; k < i; k++) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[i * ld[2] + j] -= A[i * ld[0] + k] * C[k * ld[2] + j];
+            }
+        }
+
+        if (!dim[1]) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[i * ld[2] + j] /= A[i * ld[0] + i];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/* Backward substitution task: the upper triangular twin of __TRSML. */
+void *__TRSMU(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const double * __restrict__ A = (const double *)data->A;
+    double * __restrict__ C = (double *)data->C;
+    int * __restrict__ dim = data->dim;
+    int * __restrict__ ld = data->ld;
+
+    for (int i = dim[0] - 1; i >= 0; i--) {
+        for (int k = i + 1; k < dim[0]; k++) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[i * ld[2] + j] -= A[i * ld[0] + k] * C[k * ld[2] + j];
+            }
+        }
+
+        if (!dim[1]) {
+            for (int j = 0; j < dim[2]; j++) {
+                C[i * ld[2] + j] /= A[i * ld[0] + i];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Triangular solve with multiple right hand sides, in place in B.
+ * Right hand side columns are independent, so B is cut into column tiles of width blkSz
+ * which run in parallel on the worker pool.
+ */
+void TRSM(const double * __restrict__ A, double * __restrict__ B, int n, int nrhs, int ldA, int ldB,
+          _Bool lower, _Bool unit, int blkSz) {
+    STAT_ENTER;
+
+    int nBlk = (nrhs - 1) / blkSz + 1;
+
+    POOL_INIT(0);
+    Data * __restrict__ data = (Data *)malloc(nBlk * sizeof(Data));
+
+    for (int j = 0; j < nBlk; j++) {
+        data[j].A = A;
+        data[j].C = B + j * blkSz;
+        data[j].dim[0] = n;
+        data[j].dim[1] = unit;
+        data[j].dim[2] = MIN(blkSz, nrhs - j * blkSz);
+        data[j].ld[0] = ldA;
+        data[j].ld[2] = ldB;
+
+        __POOLSubmit(lower ? __TRSML : __TRSMU, &data[j]);
+    }
+
+    __POOLWait();
+    free(data);
+
+    STAT_LEAVE(ST_TRSM);
+
+    return;
+}
+
+/*
+ * Solves AX = B in one native pass: partial-pivoting LU of A in place, row permutation of B,
+ * then a unit lower and an upper triangular solve, all without surfacing back to Python in between.
+ * On a singular A, *flag carries the LU failure column and B is left partially permuted but unsolved.
+ */
+void SOLVE(double * __restrict__ A, double * __restrict__ B, int * __restrict__ flag, int n, int nrhs,
+           int ldA, int ldB, double tol) {
+    STAT_ENTER;
+
+    int * __restrict__ p = (int *)malloc(n * sizeof(int));
+
+    for (int i = 0; i < n; i++) {
+        p[i] = i;
+    }
+
+    __LUPP(A, p, flag, n, n, ldA, tol);
+
+    if (*flag < n) {
+        free(p);
+
+        STAT_LEAVE(ST_SOLVE);
+
+        return;
+    }
+
+    double * __restrict__ tmp = (double *)malloc((size_t)n * ldB * sizeof(double));
+    memcpy(tmp, B, (size_t)n * ldB * sizeof(double));
+
+    for (int i = 0; i < n; i++) {
+        memcpy(B + (size_t)i * ldB, tmp + (size_t)p[i] * ldB, nrhs * sizeof(double));
+    }
+
+    free(tmp);
+    free(p);
+
+    TRSM(A, B, n, nrhs, ldA, ldB, TRUE, TRUE, tunePnl);
+    TRSM(A, B, n, nrhs, ldA, ldB, FALSE, FALSE, tunePnl);
+
+    STAT_LEAVE(ST_SOLVE);
+
+    return;
+}
+
+/*
+ * Determinant through partial-pivoting LU: the product of the U diagonal, sign-corrected by the
+ * parity of the row permutation (recovered from the cycle structure of p).
+ * On a singular input the determinant is exactly zero and *flag carries the LU failure column.
+ */
+void DET(double * __restrict__ A, double * __restrict__ det, int * __restrict__ flag, int n, int ld, double tol) {
+    STAT_ENTER;
+
+    int * __restrict__ p = (int *)malloc(n * sizeof(int));
+
+    for (int i = 0; i < n; i++) {
+        p[i] = i;
+    }
+
+    __LUPP(A, p, flag, n, n, ld, tol);
+
+    if (*flag < n) {
+        *det = 0;
+        free(p);
+
+        STAT_LEAVE(ST_DET);
+
+        return;
+    }
+
+    double res = 1;
+
+    for (int i = 0; i < n; i++) {
+        res *= A[(size_t)i * ld + i];
+    }
+
+    for (int i = 0; i < n; i++) {
+        int j = i;
+
+        while (p[j] >= 0) {
+            int next = p[j];
+
+            p[j] = -1;
+            j = next;
+
+            if (p[j] >= 0) {
+                res = -res;
+            }
+        }
+    }
+
+    *det = res;
+    free(p);
+
+    STAT_LEAVE(ST_DET);
+
+    return;
+}
+
+/*
+ * Matrix inverse as a multi right hand side identity solve.
+ * B is filled with I and handed to SOLVE, so the factorization, permutation and both triangular
+ * solves all happen in one native pass; on a singular input *flag carries the LU failure column.
+ */
+void INV(double * __restrict__ A, double * __restrict__ B, int * __restrict__ flag, int n, int ldA, int ldB,
+         double tol) {
+    STAT_ENTER;
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            B[(size_t)i * ldB + j] = i == j;
+        }
+    }
+
+    SOLVE(A, B, flag, n, n, ldA, ldB, tol);
+
+    STAT_LEAVE(ST_INV);
+
+    return;
+}
+
+/*
+ * Elementwise task over one chunk of double buffers.
+ * dim[1] carries the operator and dim[2] the broadcast mode: 0 both operands are full buffers,
+ * 1 the right operand is a single scalar, 2 the left one is.  Broadcasting is expressed as a zero
+ * stride so every operator needs just one loop, which the compiler can vectorize.
+ * Modulus and floor division follow Python semantics (result takes the sign of the divisor).
+ */
+void *__EWISEF(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const double * __restrict__ A = (const double *)data->A;
+    const double * __restrict__ B = (const double *)data->B;
+    double * __restrict__ C = (double *)data->C;
+    long n = data->dim[0];
+    long dA = data->dim[2] == 2 ? 0 : 1;
+    long dB = data->dim[2] == 1 ? 0 : 1;
+    double r;
+
+    switch (data->dim[1]) {
+    case EW_ADD:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] + B[i * dB];
+        }
+
+        break;
+    case EW_SUB:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] - B[i * dB];
+        }
+
+        break;
+    case EW_MUL:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] * B[i * dB];
+        }
+
+        break;
+    case EW_DIV:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] / B[i * dB];
+        }
+
+        break;
+    case EW_FLR:
+        for (long i = 0; i < n; i++) {
+            C[i] = floor(A[i * dA] / B[i * dB]);
+        }
+
+        break;
+    case EW_POW:
+        for (long i = 0; i < n; i++) {
+            C[i] = pow(A[i * dA], B[i * dB]);
+        }
+
+        break;
+    case EW_MOD:
+        for (long i = 0; i < n; i++) {
+            r = fmod(A[i * dA], B[i * dB]);
+
+            if (r != 0 && (r < 0) != (B[i * dB] < 0)) {
+                r += B[i * dB];
+            }
+
+            C[i] = r;
+        }
+
+        break;
+    case EW_NEG:
+        for (long i = 0; i < n; i++) {
+            C[i] = -A[i];
+        }
+
+        break;
+    case EW_LT:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] < B[i * dB];
+        }
+
+        break;
+    case EW_LE:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] <= B[i * dB];
+        }
+
+        break;
+    case EW_GT:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] > B[i * dB];
+        }
+
+        break;
+    case EW_GE:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] >= B[i * dB];
+        }
+
+        break;
+    case EW_EQ:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] == B[i * dB];
+        }
+
+        break;
+    case EW_NE:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] != B[i * dB];
+        }
+
+        break;
+    }
+
+    return NULL;
+}
+
+/*
+ * Long twin of __EWISEF.
+ * True division and pow never come through here; CLibrary promotes those to the double kernel
+ * (or keeps them in Python when the integer result must be preserved).
+ */
+void *__EWISEI(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const long * __restrict__ A = (const long *)data->A;
+    const long * __restrict__ B = (const long *)data->B;
+    long * __restrict__ C = (long *)data->C;
+    long n = data->dim[0];
+    long dA = data->dim[2] == 2 ? 0 : 1;
+    long dB = data->dim[2] == 1 ? 0 : 1;
+    long q, r;
+
+    switch (data->dim[1]) {
+    case EW_ADD:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] + B[i * dB];
+        }
+
+        break;
+    case EW_SUB:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] - B[i * dB];
+        }
+
+        break;
+    case EW_MUL:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] * B[i * dB];
+        }
+
+        break;
+    case EW_FLR:
+        for (long i = 0; i < n; i++) {
+            q = A[i * dA] / B[i * dB];
+
+            if (A[i * dA] % B[i * dB] != 0 && (A[i * dA] < 0) != (B[i * dB] < 0)) {
+                q--;
+            }
+
+            C[i] = q;
+        }
+
+        break;
+    case EW_MOD:
+        for (long i = 0; i < n; i++) {
+            r = A[i * dA] % B[i * dB];
+
+            if (r != 0 && (r < 0) != (B[i * dB] < 0)) {
+                r += B[i * dB];
+            }
+
+            C[i] = r;
+        }
+
+        break;
+    case EW_NEG:
+        for (long i = 0; i < n; i++) {
+            C[i] = -A[i];
+        }
+
+        break;
+    case EW_LT:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] < B[i * dB];
+        }
+
+        break;
+    case EW_LE:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] <= B[i * dB];
+        }
+
+        break;
+    case EW_GT:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] > B[i * dB];
+        }
 
-#define TRUE 1
-#define FALSE 0
-#define MIN(a, b) ((a) > (b) ? (b) : (a))
+        break;
+    case EW_GE:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] >= B[i * dB];
+        }
 
-typedef struct _Data {
-    const void ** __restrict__ A;
-    const void ** __restrict__ B;
-    void ** __restrict__ C;
-    int dim[3];
-    int blkIdx[3];
-    int blkSz;
-} Data;
+        break;
+    case EW_EQ:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] == B[i * dB];
+        }
 
-pthread_mutex_t mutex;
+        break;
+    case EW_NE:
+        for (long i = 0; i < n; i++) {
+            C[i] = A[i * dA] != B[i * dB];
+        }
 
-void *__GEMMI(void *arg);
-void *__GEMMF(void *arg);
-void GEMM(const void ** __restrict__ A, const void ** __restrict__ B, void ** __restrict__ C, int l, int m, int n,
-          int blkSz, _Bool intMat);
+        break;
+    }
 
-void __LUPP(double ** __restrict__ A, int * __restrict__ p, int * __restrict__ flag, int m, int n, double tol);
-void __LUCP(double ** __restrict__ A, int * __restrict__ p, int * __restrict__ q, int * __restrict__ flag,
-            int m, int n, double tol);
-void LU(double ** __restrict__ A, int * __restrict__ p, int * __restrict__ q, int * __restrict__ flag,
-        int m, int n, _Bool cp, double tol);
+    return NULL;
+}
 
-void CHOL(double ** __restrict__ A, int * __restrict__ flag, int n, double tol);
+/*
+ * Elementwise operator over contiguous buffers of n entries, C = A op B.
+ * A broadcast operand (bcast 1 for B, 2 for A) is a single scalar read by every element.
+ * The range is cut into EW_CHUNK chunks which run in parallel on the worker pool;
+ * the loops themselves are left to the compiler's vectorizer, which handles these
+ * straight-line streaming patterns well.
+ */
+void EWISE(const void * __restrict__ A, const void * __restrict__ B, void * __restrict__ C, long n, int op, int dt,
+           int bcast) {
+    STAT_ENTER;
+
+    int nChunk = (int)((n - 1) / EW_CHUNK + 1);
+    size_t elemSz = dt == DT_LONG ? sizeof(long) : sizeof(double);
+
+    POOL_INIT(0);
+    Data * __restrict__ data = (Data *)malloc(nChunk * sizeof(Data));
+
+    for (int c = 0; c < nChunk; c++) {
+        long off = (long)c * EW_CHUNK;
+
+        data[c].A = (const char *)A + (bcast == 2 ? 0 : off * elemSz);
+        data[c].B = (const char *)B + (bcast == 1 ? 0 : off * elemSz);
+        data[c].C = (char *)C + off * elemSz;
+        data[c].dim[0] = (int)MIN(EW_CHUNK, n - off);
+        data[c].dim[1] = op;
+        data[c].dim[2] = bcast;
+
+        __POOLSubmit(dt == DT_LONG ? __EWISEI : __EWISEF, &data[c]);
+    }
 
-void QR(double ** __restrict__ A, double * __restrict__ v, int * __restrict__ flag, int m, int n, double tol);
+    __POOLWait();
+    free(data);
 
-void *__GEMMI(void *arg) {
+    STAT_LEAVE(ST_EWISE);
+
+    return;
+}
+
+/*
+ * Fused elementwise task over one chunk of double buffers.
+ * A (via Data) holds the chunk-local operand pointers and B the postfix program:
+ * an entry e >= 0 pushes operand e >> 1 (broadcast as a scalar when e & 1),
+ * an entry e < 0 applies the EwOp -(e + 1) to the top of the stack.
+ * The stack holds FUSE_BLK values per slot and the program runs block by block,
+ * so each instruction is a straight-line loop the compiler can vectorize
+ * and every operand is streamed through memory exactly once for the whole chain.
+ */
+void *__EWFUSEF(void *arg) {
     Data * __restrict__ data = (Data *)arg;
-    const long ** __restrict__ A = (const long **)data->A;
-    const long ** __restrict__ B = (const long **)data->B;
-    long ** __restrict__ C = (long **)data->C;
-    int * __restrict__ dim = data->dim;
-    int * __restrict__ blkIdx = data->blkIdx;
-    int blkSz = data->blkSz;
-    long ** __restrict__ tmp = (long **)malloc(dim[0] * sizeof(long *));
+    const double * const * __restrict__ opnd = (const double * const *)data->A;
+    const long * __restrict__ prog = (const long *)data->B;
+    double * __restrict__ C = (double *)data->C;
+    long n = data->dim[0];
+    long nProg = data->dim[1];
+    double stk[FUSE_STK][FUSE_BLK];
+    double r;
+
+    for (long i = 0; i < n; i += FUSE_BLK) {
+        long m = MIN(FUSE_BLK, n - i);
+        int sp = 0;
+
+        for (long k = 0; k < nProg; k++) {
+            long e = prog[k];
+
+            if (e >= 0) {
+                const double * __restrict__ p = opnd[e >> 1];
+                long s = e & 1 ? 0 : 1;
+
+                for (long j = 0; j < m; j++) {
+                    stk[sp][j] = p[(i + j) * s];
+                }
 
-    for (int i = 0; i < dim[0]; i++) {
-        tmp[i] = (long *)malloc(dim[2] * sizeof(long));
+                sp++;
 
-        for (int j = 0; j < dim[2]; j++) {
-            tmp[i][j] = 0;
-        }
-    }
+                continue;
+            }
 
-    for (int i = 0; i < dim[0]; i++) {
-        for (int k = 0; k < dim[1]; k++) {
-            for (int j = 0; j < dim[2]; j++) {
-                tmp[i][j] += A[blkIdx[0] * blkSz + i][blkIdx[1] * blkSz + k]
-                             * B[blkIdx[1] * blkSz + k][blkIdx[2] * blkSz + j];
+            switch (-(e + 1)) {
+            case EW_ADD:
+                for (long j = 0; j < m; j++) {
+                    stk[sp - 2][j] += stk[sp - 1][j];
+                }
+
+                sp--;
+                break;
+            case EW_SUB:
+                for (long j = 0; j < m; j++) {
+                    stk[sp - 2][j] -= stk[sp - 1][j];
+                }
+
+                sp--;
+                break;
+            case EW_MUL:
+                for (long j = 0; j < m; j++) {
+                    stk[sp - 2][j] *= stk[sp - 1][j];
+                }
+
+                sp--;
+                break;
+            case EW_DIV:
+                for (long j = 0; j < m; j++) {
+                    stk[sp - 2][j] /= stk[sp - 1][j];
+                }
+
+                sp--;
+                break;
+            case EW_FLR:
+                for (long j = 0; j < m; j++) {
+                    stk[sp - 2][j] = floor(stk[sp - 2][j] / stk[sp - 1][j]);
+                }
+
+                sp--;
+                break;
+            case EW_POW:
+                for (long j = 0; j < m; j++) {
+                    stk[sp - 2][j] = pow(stk[sp - 2][j], stk[sp - 1][j]);
+                }
+
+                sp--;
+                break;
+            case EW_MOD:
+                for (long j = 0; j < m; j++) {
+                    r = fmod(stk[sp - 2][j], stk[sp - 1][j]);
+
+                    if (r != 0 && (r < 0) != (stk[sp - 1][j] < 0)) {
+                        r += stk[sp - 1][j];
+                    }
+
+                    stk[sp - 2][j] = r;
+                }
+
+                sp--;
+                break;
+            case EW_NEG:
+                for (long j = 0; j < m; j++) {
+                    stk[sp - 1][j] = -stk[sp - 1][j];
+                }
+
+                break;
             }
         }
-    }
-
-    pthread_mutex_lock(&mutex);
 
-    for (int i = 0; i < dim[0]; i++) {
-        for (int j = 0; j < dim[2]; j++) {
-            C[blkIdx[0] * blkSz + i][blkIdx[2] * blkSz + j] += tmp[i][j];
+        for (long j = 0; j < m; j++) {
+            C[i + j] = stk[0][j];
         }
     }
 
-    pthread_mutex_unlock(&mutex);
-    free(tmp);
-    pthread_exit(0);
+    return NULL;
 }
 
-void *__GEMMF(void *arg) {
+/*
+ * Long twin of __EWFUSEF.
+ * True division and pow never come through here; CLibrary promotes those chains to the double kernel
+ * (or keeps them in Python when the integer result must be preserved).
+ */
+void *__EWFUSEI(void *arg) {
     Data * __restrict__ data = (Data *)arg;
-    const double ** __restrict__ A = (const double **)data->A;
-    const double ** __restrict__ B = (const double **)data->B;
-    double ** __restrict__ C = (double **)data->C;
-    int * __restrict__ dim = data->dim;
-    int * __restrict__ blkIdx = data->blkIdx;
-    int blkSz = data->blkSz;
-    double ** __restrict__ tmp = (double **)malloc(dim[0] * sizeof(double *));
+    const long * const * __restrict__ opnd = (const long * const *)data->A;
+    const long * __restrict__ prog = (const long *)data->B;
+    long * __restrict__ C = (long *)data->C;
+    long n = data->dim[0];
+    long nProg = data->dim[1];
+    long stk[FUSE_STK][FUSE_BLK];
+    long q, r;
+
+    for (long i = 0; i < n; i += FUSE_BLK) {
+        long m = MIN(FUSE_BLK, n - i);
+        int sp = 0;
+
+        for (long k = 0; k < nProg; k++) {
+            long e = prog[k];
+
+            if (e >= 0) {
+                const long * __restrict__ p = opnd[e >> 1];
+                long s = e & 1 ? 0 : 1;
+
+                for (long j = 0; j < m; j++) {
+                    stk[sp][j] = p[(i + j) * s];
+                }
 
-    for (int i = 0; i < dim[0]; i++) {
-        tmp[i] = (double *)malloc(dim[2] * sizeof(double));
+                sp++;
 
-        for (int j = 0; j < dim[2]; j++) {
-            tmp[i][j] = 0;
-        }
-    }
+                continue;
+            }
 
-    for (int i = 0; i < dim[0]; i++) {
-        for (int k = 0; k < dim[1]; k++) {
-            for (int j = 0; j < dim[2]; j++) {
-                tmp[i][j] += A[blkIdx[0] * blkSz + i][blkIdx[1] * blkSz + k]
-                             * B[blkIdx[1] * blkSz + k][blkIdx[2] * blkSz + j];
+            switch (-(e + 1)) {
+            case EW_ADD:
+                for (long j = 0; j < m; j++) {
+                    stk[sp - 2][j] += stk[sp - 1][j];
+                }
+
+                sp--;
+                break;
+            case EW_SUB:
+                for (long j = 0; j < m; j++) {
+                    stk[sp - 2][j] -= stk[sp - 1][j];
+                }
+
+                sp--;
+                break;
+            case EW_MUL:
+                for (long j = 0; j < m; j++) {
+                    stk[sp - 2][j] *= stk[sp - 1][j];
+                }
+
+                sp--;
+                break;
+            case EW_FLR:
+                for (long j = 0; j < m; j++) {
+                    q = stk[sp - 2][j] / stk[sp - 1][j];
+
+                    if (stk[sp - 2][j] % stk[sp - 1][j] != 0 && (stk[sp - 2][j] < 0) != (stk[sp - 1][j] < 0)) {
+                        q--;
+                    }
+
+                    stk[sp - 2][j] = q;
+                }
+
+                sp--;
+                break;
+            case EW_MOD:
+                for (long j = 0; j < m; j++) {
+                    r = stk[sp - 2][j] % stk[sp - 1][j];
+
+                    if (r != 0 && (r < 0) != (stk[sp - 1][j] < 0)) {
+                        r += stk[sp - 1][j];
+                    }
+
+                    stk[sp - 2][j] = r;
+                }
+
+                sp--;
+                break;
+            case EW_NEG:
+                for (long j = 0; j < m; j++) {
+                    stk[sp - 1][j] = -stk[sp - 1][j];
+                }
+
+                break;
             }
         }
-    }
-
-    pthread_mutex_lock(&mutex);
 
-    for (int i = 0; i < dim[0]; i++) {
-        for (int j = 0; j < dim[2]; j++) {
-            C[blkIdx[0] * blkSz + i][blkIdx[2] * blkSz + j] += tmp[i][j];
+        for (long j = 0; j < m; j++) {
+            C[i + j] = stk[0][j];
         }
     }
 
-    pthread_mutex_unlock(&mutex);
-    free(tmp);
-    pthread_exit(0);
+    return NULL;
 }
 
-void GEMM(const void ** __restrict__ A, const void ** __restrict__ B, void ** __restrict__ C, int l, int m, int n,
-          int blkSz, _Bool intMat) {
-    int lBlk = (l - 1) / blkSz + 1;
-    int mBlk = (m - 1) / blkSz + 1;
-    int nBlk = (n - 1) / blkSz + 1;
+/*
+ * Fused elementwise program over contiguous buffers of n entries.
+ * opnd holds the operand buffers and prog the postfix program; refer to the comments of __EWFUSEF.
+ * A whole chain like A + B * C - D thus costs one pass over memory instead of one per operator.
+ * The range is cut into EW_CHUNK chunks which run in parallel on the worker pool;
+ * each chunk gets its own operand pointer array pre-offset into the chunk,
+ * so the workers never need the broadcast flags beyond the stride bit in the program.
+ */
+void EWFUSE(const void * const * __restrict__ opnd, const long * __restrict__ prog, long nProg,
+            void * __restrict__ C, long n, int dt) {
+    STAT_ENTER;
+
+    int nChunk = (int)((n - 1) / EW_CHUNK + 1);
+    size_t elemSz = dt == DT_LONG ? sizeof(long) : sizeof(double);
+    long nOpnd = 0;
+
+    for (long k = 0; k < nProg; k++) {
+        if (prog[k] >= 0 && (prog[k] >> 1) + 1 > nOpnd) {
+            nOpnd = (prog[k] >> 1) + 1;
+        }
+    }
 
-    pthread_mutex_init(&mutex, NULL);
-    pthread_t * __restrict__ threads = (pthread_t *)malloc(lBlk * mBlk * nBlk * sizeof(pthread_t));
-    Data * __restrict__ data = (Data *)malloc(lBlk * mBlk * nBlk * sizeof(Data));
-    int cnt = 0;
+    POOL_INIT(0);
+    Data * __restrict__ data = (Data *)malloc(nChunk * sizeof(Data));
+    const void ** __restrict__ loc = (const void **)malloc(nChunk * nOpnd * sizeof(void *));
 
-    for (int i = 0; i < lBlk; i++) {
-        for (int j = 0; j < mBlk; j++) {
-            for (int k = 0; k < nBlk; k++) {
-                data[cnt].A = A;
-                data[cnt].B = B;
-                data[cnt].C = C;
-                data[cnt].dim[0] = MIN(blkSz, l - blkSz * i);
-                data[cnt].dim[1] = MIN(blkSz, m - blkSz * j);
-                data[cnt].dim[2] = MIN(blkSz, n - blkSz * k);
-                data[cnt].blkIdx[0] = i;
-                data[cnt].blkIdx[1] = j;
-                data[cnt].blkIdx[2] = k;
-                data[cnt].blkSz = blkSz;
-
-                if (intMat) {
-                    pthread_create(&threads[cnt], NULL, __GEMMI, &data[cnt]);
-                } else {
-                    pthread_create(&threads[cnt], NULL, __GEMMF, &data[cnt]);
-                }
+    for (int c = 0; c < nChunk; c++) {
+        long off = (long)c * EW_CHUNK;
 
-                cnt++;
+        for (long k = 0; k < nProg; k++) {
+            if (prog[k] >= 0) {
+                long i = prog[k] >> 1;
+
+                loc[c * nOpnd + i] = (const char *)opnd[i] + (prog[k] & 1 ? 0 : off * elemSz);
             }
         }
-    }
 
-    for (int i = 0; i < cnt; i++) {
-        pthread_join(threads[i], NULL);
+        data[c].A = &loc[c * nOpnd];
+        data[c].B = prog;
+        data[c].C = (char *)C + off * elemSz;
+        data[c].dim[0] = (int)MIN(EW_CHUNK, n - off);
+        data[c].dim[1] = (int)nProg;
+
+        __POOLSubmit(dt == DT_LONG ? __EWFUSEI : __EWFUSEF, &data[c]);
     }
 
-    free(threads);
+    __POOLWait();
+    free(loc);
     free(data);
 
+    STAT_LEAVE(ST_EWFUSE);
+
     return;
 }
 
-void __LUPP(double ** __restrict__ A, int * __restrict__ p, int * __restrict__ flag, int m, int n, double tol) {
-    int pv, pv_tmp;
-    double *r_tmp;
-    int l = MIN(m, n);
+/*
+ * Reduction task over one chunk of double buffers; dim[1] carries the operator.
+ * The partial lands in the RdPart slot behind C.  Extremum indices are chunk-relative,
+ * offset back to absolute positions by the driver.
+ */
+void *__REDUCEF(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const double * __restrict__ A = (const double *)data->A;
+    const double * __restrict__ B = (const double *)data->B;
+    RdPart * __restrict__ part = (RdPart *)data->C;
+    long n = data->dim[0];
+    double acc;
+    long at = 0;
+
+    switch (data->dim[1]) {
+    case RD_SUM:
+        acc = 0;
+
+        for (long i = 0; i < n; i++) {
+            acc += A[i];
+        }
 
-    for (int i = 0; i < l - 1; i++) {
-        pv = i;
+        break;
+    case RD_PROD:
+        acc = 1;
 
-        for (int j = i + 1; j < m; j++) {
-            if (fabs(A[pv][i]) < fabs(A[j][i])) {
-                pv = j;
-            }
+        for (long i = 0; i < n; i++) {
+            acc *= A[i];
         }
 
-        if (pv != i) {
-            pv_tmp = p[pv];
-            p[pv] = p[i];
-            p[i] = pv_tmp;
+        break;
+    case RD_DOT:
+        acc = 0;
 
-            r_tmp = A[pv];
-            A[pv] = A[i];
-            A[i] = r_tmp;
+        for (long i = 0; i < n; i++) {
+            acc += A[i] * B[i];
         }
 
+        break;
+    case RD_NRM1:
+        acc = 0;
 
-        if (fabs(A[i][i]) < tol) {
-            *flag = i;
+        for (long i = 0; i < n; i++) {
+            acc += fabs(A[i]);
+        }
 
-            return;
+        break;
+    case RD_NRM2:
+        acc = 0;
+
+        for (long i = 0; i < n; i++) {
+            acc += A[i] * A[i];
         }
 
-        for (int j = i + 1; j < m; j++) {
-            A[j][i] /= A[i][i];
+        break;
+    case RD_NRMINF:
+        acc = 0;
 
-            for (int k = i + 1; k < n; k++) {
-                A[j][k] -= A[j][i] * A[i][k];
+        for (long i = 0; i < n; i++) {
+            if (fabs(A[i]) > acc) {
+                acc = fabs(A[i]);
+            }
+        }
+
+        break;
+    case RD_MIN:
+        acc = A[0];
+
+        for (long i = 1; i < n; i++) {
+            if (A[i] < acc) {
+                acc = A[i];
+                at = i;
+            }
+        }
+
+        break;
+    default:
+        acc = A[0];
+
+        for (long i = 1; i < n; i++) {
+            if (A[i] > acc) {
+                acc = A[i];
+                at = i;
             }
         }
+
+        break;
     }
 
-    *flag = fabs(A[l - 1][l - 1]) < tol ? (l - 1) : l;
+    part->f = acc;
+    part->idx = at;
 
-    return;
+    return NULL;
 }
 
-void __LUCP(double ** __restrict__ A, int * __restrict__ p, int * __restrict__ q, int * __restrict__ flag,
-            int m, int n, double tol) {
-    int pv1, pv2, pv_tmp;
-    double *r_tmp, c_tmp;
-    int l = MIN(m, n);
+/*
+ * Long twin of __REDUCEF.
+ * Norms never come through here; CLibrary promotes those to the double kernel.
+ */
+void *__REDUCEI(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+    const long * __restrict__ A = (const long *)data->A;
+    const long * __restrict__ B = (const long *)data->B;
+    RdPart * __restrict__ part = (RdPart *)data->C;
+    long n = data->dim[0];
+    long acc;
+    long at = 0;
+
+    switch (data->dim[1]) {
+    case RD_SUM:
+        acc = 0;
+
+        for (long i = 0; i < n; i++) {
+            acc += A[i];
+        }
 
-    for (int i = 0; i < l - 1; i++) {
-        pv1 = pv2 = i;
+        break;
+    case RD_PROD:
+        acc = 1;
 
-        for (int j = i; j < m; j++) {
-            for (int k = i; k < n; k++) {
-                if (fabs(A[pv1][pv2]) < fabs(A[j][k])) {
-                    pv1 = j;
-                    pv2 = k;
-                }
-            }
+        for (long i = 0; i < n; i++) {
+            acc *= A[i];
         }
 
-        if (pv1 != i) {
-            pv_tmp = p[pv1];
-            p[pv1] = p[i];
-            p[i] = pv_tmp;
+        break;
+    case RD_DOT:
+        acc = 0;
 
-            r_tmp = A[pv1];
-            A[pv1] = A[i];
-            A[i] = r_tmp;
+        for (long i = 0; i < n; i++) {
+            acc += A[i] * B[i];
         }
 
-        if (pv2 != i) {
-            pv_tmp = q[pv2];
-            q[pv2] = q[i];
-            q[i] = pv_tmp;
+        break;
+    case RD_MIN:
+        acc = A[0];
 
-            for (int j = 0; j < m; j++) {
-                c_tmp = A[j][i];
-                A[j][i] = A[j][pv2];
-                A[j][pv2] = c_tmp;
+        for (long i = 1; i < n; i++) {
+            if (A[i] < acc) {
+                acc = A[i];
+                at = i;
             }
         }
 
-        if (fabs(A[i][i]) < tol) {
-            *flag = i;
+        break;
+    default:
+        acc = A[0];
 
-            return;
+        for (long i = 1; i < n; i++) {
+            if (A[i] > acc) {
+                acc = A[i];
+                at = i;
+            }
         }
 
-        for (int j = i + 1; j < m; j++) {
-            A[j][i] /= A[i][i];
+        break;
+    }
 
-            for (int k = i + 1; k < n; k++) {
-                A[j][k] -= A[j][i] * A[i][k];
+    part->l = acc;
+    part->idx = at;
+
+    return NULL;
+}
+
+/*
+ * Reduction over a contiguous buffer of n entries; B is the second operand of RD_DOT and ignored otherwise.
+ * Chunks run in parallel on the worker pool and the per-chunk partials are combined serially,
+ * which also makes the summation order deterministic for a given chunk size.
+ * The result lands in *res as a long for DT_LONG and a double otherwise;
+ * for RD_MIN and RD_MAX, *idx receives the absolute position of the first extremum (otherwise -1).
+ */
+void REDUCE(const void * __restrict__ A, const void * __restrict__ B, void * __restrict__ res,
+            long * __restrict__ idx, long n, int op, int dt) {
+    STAT_ENTER;
+
+    int nChunk = (int)((n - 1) / EW_CHUNK + 1);
+    size_t elemSz = dt == DT_LONG ? sizeof(long) : sizeof(double);
+
+    POOL_INIT(0);
+    Data * __restrict__ data = (Data *)malloc(nChunk * sizeof(Data));
+    RdPart * __restrict__ part = (RdPart *)malloc(nChunk * sizeof(RdPart));
+
+    for (int c = 0; c < nChunk; c++) {
+        long off = (long)c * EW_CHUNK;
+
+        data[c].A = (const char *)A + off * elemSz;
+        data[c].B = (const char *)B + off * elemSz;
+        data[c].C = &part[c];
+        data[c].dim[0] = (int)MIN(EW_CHUNK, n - off);
+        data[c].dim[1] = op;
+
+        __POOLSubmit(dt == DT_LONG ? __REDUCEI : __REDUCEF, &data[c]);
+    }
+
+    __POOLWait();
+    *idx = -1;
+
+    if (dt == DT_LONG) {
+        long acc = part[0].l;
+        long at = part[0].idx;
+
+        for (int c = 1; c < nChunk; c++) {
+            switch (op) {
+            case RD_SUM:
+            case RD_DOT:
+                acc += part[c].l;
+
+                break;
+            case RD_PROD:
+                acc *= part[c].l;
+
+                break;
+            case RD_MIN:
+                if (part[c].l < acc) {
+                    acc = part[c].l;
+                    at = (long)c * EW_CHUNK + part[c].idx;
+                }
+
+                break;
+            default:
+                if (part[c].l > acc) {
+                    acc = part[c].l;
+                    at = (long)c * EW_CHUNK + part[c].idx;
+                }
+
+                break;
+            }
+        }
+
+        if (op == RD_MIN || op == RD_MAX) {
+            *idx = at;
+        }
+
+        *(long *)res = acc;
+    } else {
+        double acc = part[0].f;
+        long at = part[0].idx;
+
+        for (int c = 1; c < nChunk; c++) {
+            switch (op) {
+            case RD_SUM:
+            case RD_DOT:
+            case RD_NRM1:
+            case RD_NRM2:
+                acc += part[c].f;
+
+                break;
+            case RD_PROD:
+                acc *= part[c].f;
+
+                break;
+            case RD_NRMINF:
+                acc = part[c].f > acc ? part[c].f : acc;
+
+                break;
+            case RD_MIN:
+                if (part[c].f < acc) {
+                    acc = part[c].f;
+                    at = (long)c * EW_CHUNK + part[c].idx;
+                }
+
+                break;
+            default:
+                if (part[c].f > acc) {
+                    acc = part[c].f;
+                    at = (long)c * EW_CHUNK + part[c].idx;
+                }
+
+                break;
             }
         }
+
+        if (op == RD_MIN || op == RD_MAX) {
+            *idx = at;
+        }
+
+        *(double *)res = op == RD_NRM2 ? sqrt(acc) : acc;
     }
 
-    *flag = fabs(A[l - 1][l - 1]) < tol ? (l - 1) : l;
+    free(data);
+    free(part);
+
+    STAT_LEAVE(ST_REDUCE);
 
     return;
 }
 
-void LU(double ** __restrict__ A, int * __restrict__ p, int * __restrict__ q, int * __restrict__ flag,
-        int m, int n, _Bool cp, double tol) {
-    if (cp) {
-        __LUCP(A, p, q, flag, m, n, tol);
+/*
+ * Cache-oblivious transpose of an m by n tile: B[j][i] = A[i][j].
+ *
+ * The recursion halves the longer dimension until the tile fits in TR_BLK on both sides,
+ * so every recursion level roughly halves the working set and the base case touches
+ * at most TR_BLK cache lines of B no matter how wide the full matrix is.
+ * A plain doubly nested loop instead strides through B by the full row length,
+ * which thrashes the cache as soon as m exceeds the number of available lines.
+ */
+static void __TRANSFRec(const double * __restrict__ A, double * __restrict__ B, long m, long n, long ldA, long ldB) {
+    if (m <= TR_BLK && n <= TR_BLK) {
+        for (long i = 0; i < m; i++) {
+            for (long j = 0; j < n; j++) {
+                B[j * ldB + i] = A[i * ldA + j];
+            }
+        }
+    } else if (m >= n) {
+        long h = m / 2;
+
+        __TRANSFRec(A, B, h, n, ldA, ldB);
+        __TRANSFRec(A + h * ldA, B + h, m - h, n, ldA, ldB);
     } else {
-        __LUPP(A, p, flag, m, n, tol);
+        long h = n / 2;
+
+        __TRANSFRec(A, B, m, h, ldA, ldB);
+        __TRANSFRec(A + h, B + h * ldB, m, n - h, ldA, ldB);
     }
 
     return;
 }
 
-void CHOL(double ** __restrict__ A, int * __restrict__ flag, int n, double tol) {
-    double tmp;
+static void __TRANSIRec(const long * __restrict__ A, long * __restrict__ B, long m, long n, long ldA, long ldB) {
+    if (m <= TR_BLK && n <= TR_BLK) {
+        for (long i = 0; i < m; i++) {
+            for (long j = 0; j < n; j++) {
+                B[j * ldB + i] = A[i * ldA + j];
+            }
+        }
+    } else if (m >= n) {
+        long h = m / 2;
 
-    for (int i = 0; i < n; i++) {
-        if (A[i][i] < tol) {
-            *flag = i;
+        __TRANSIRec(A, B, h, n, ldA, ldB);
+        __TRANSIRec(A + h * ldA, B + h, m - h, n, ldA, ldB);
+    } else {
+        long h = n / 2;
 
-            return;
-        }
+        __TRANSIRec(A, B, m, h, ldA, ldB);
+        __TRANSIRec(A + h, B + h * ldB, m, n - h, ldA, ldB);
+    }
 
-        for (int j = i + 1; j < n; j++) {
-            tmp = A[i][j] / A[i][i];
+    return;
+}
 
-            for (int k = j; k < n; k++) {
-                A[j][k] -= tmp * A[i][k];
-            }
-        }
+/*
+ * Transpose task over one horizontal slice of rows; dim[0] by dim[1] with leading dimensions in ld.
+ * Each slice lands in a disjoint band of columns of B, so tasks never overlap.
+ */
+void *__TRANSF(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
 
-        tmp = sqrt(A[i][i]);
+    __TRANSFRec((const double *)data->A, (double *)data->C, data->dim[0], data->dim[1], data->ld[0], data->ld[1]);
 
-        for (int j = i; j < n; j++) {
-            A[i][j] /= tmp;
-        }
+    return NULL;
+}
+
+void *__TRANSI(void *arg) {
+    Data * __restrict__ data = (Data *)arg;
+
+    __TRANSIRec((const long *)data->A, (long *)data->C, data->dim[0], data->dim[1], data->ld[0], data->ld[1]);
+
+    return NULL;
+}
+
+/*
+ * Out-of-place transpose driver: B = A' for an m by n row-major A, both tightly packed.
+ *
+ * Rows are split into horizontal slices of roughly EW_CHUNK elements each and submitted to the pool;
+ * inside a slice the cache-oblivious recursion above does the actual element movement.
+ */
+void TRANS(const void * __restrict__ A, void * __restrict__ B, long m, long n, int dt) {
+    STAT_ENTER;
+
+    size_t elemSz = dt == DT_LONG ? sizeof(long) : sizeof(double);
+    long rows = EW_CHUNK / n + 1;
+    int nChunk = (int)((m - 1) / rows + 1);
+
+    POOL_INIT(0);
+    Data * __restrict__ data = (Data *)malloc(nChunk * sizeof(Data));
+
+    for (int c = 0; c < nChunk; c++) {
+        long off = (long)c * rows;
+
+        data[c].A = (const char *)A + off * n * elemSz;
+        data[c].B = NULL;
+        data[c].C = (char *)B + off * elemSz;
+        data[c].dim[0] = (int)MIN(rows, m - off);
+        data[c].dim[1] = (int)n;
+        data[c].ld[0] = (int)n;
+        data[c].ld[1] = (int)m;
+
+        __POOLSubmit(dt == DT_LONG ? __TRANSI : __TRANSF, &data[c]);
     }
 
-    *flag = n;
+    __POOLWait();
+    free(data);
+
+    STAT_LEAVE(ST_TRANS);
 
     return;
 }
 
-void QR(double ** __restrict__ A, double * __restrict__ v, int * __restrict__ flag, int m, int n, double tol) {
+/*
+ * Unblocked Householder factorization of one panel: kernel rows i0 .. i0 + nb - 1.
+ * Identical to the old scalar loop except that reflector applications stop at the panel edge;
+ * columns right of the panel receive all nb reflectors at once through the WY update in the caller.
+ * On a zero column norm, *flag is set to the offending reflector index; otherwise it is left untouched.
+ */
+static void __QRPanel(double * __restrict__ A, double * __restrict__ v, int * __restrict__ flag,
+                      int n, int ld, int i0, int nb, double tol) {
     double norm, u1, tmp;
     int s;
-    int l = MIN(m, n - 1);
 
-    for (int i = 0; i < l; i++) {
+    for (int i = i0; i < i0 + nb; i++) {
         norm = 0;
-        s = A[i][i] < 0 ? -1 : 1;
+        s = A[i * ld + i] < 0 ? -1 : 1;
 
         for (int j = i; j < n; j++) {
-            norm += A[i][j] * A[i][j];
+            norm += A[i * ld + j] * A[i * ld + j];
         }
 
         norm = sqrt(norm);
-        u1 = A[i][i] + s * norm;
+        u1 = A[i * ld + i] + s * norm;
 
         if (fabs(norm) < tol) {
             *flag = i;
@@ -328,32 +2673,126 @@ void QR(double ** __restrict__ A, double * __restrict__ v, int * __restrict__ fl
         }
 
         v[i] = u1 / (s * norm);
-        A[i][i] = -s * norm;
+        A[i * ld + i] = -s * norm;
 
         for (int j = i + 1; j < n; j++) {
-            A[i][j] /= u1;
+            A[i * ld + j] /= u1;
         }
 
-        for (int j = i + 1; j < m; j++) {
-            tmp = A[j][i];
+        for (int j = i + 1; j < i0 + nb; j++) {
+            tmp = A[j * ld + i];
 
             for (int k = i + 1; k < n; k++) {
-                tmp += A[i][k] * A[j][k];
+                tmp += A[i * ld + k] * A[j * ld + k];
             }
 
-            A[j][i] -= tmp * v[i];
+            A[j * ld + i] -= tmp * v[i];
 
             for (int k = i + 1; k < n; k++) {
-                A[j][k] -= tmp * v[i] * A[i][k];
+                A[j * ld + k] -= tmp * v[i] * A[i * ld + k];
+            }
+        }
+    }
+
+    return;
+}
+
+/*
+ * Blocked Householder QR with compact-WY aggregated updates.
+ * A arrives transposed (one kernel row per matrix column); each round factors a panel of nb
+ * reflectors with the scalar code above, builds the upper triangular T of Q = I - VTV', and hits
+ * all trailing columns with Ct -= (Ct V) T V' as three GEMM calls on explicit V scratch copies, so the bulk of the work runs
+ * on the blocked kernels instead of one memory-bound rank-1 sweep per reflector.
+ * Output layout (R on and above the diagonal, normalized reflector tails below, factors in v)
+ * and the flag semantics are unchanged.
+ */
+void QR(double * __restrict__ A, double * __restrict__ v, int * __restrict__ flag, int m, int n, int ld, double tol) {
+    STAT_ENTER;
+
+    int l = MIN(m, n - 1);
+
+    for (int i0 = 0; i0 < l; i0 += PANEL_NB) {
+        int nb = MIN(PANEL_NB, l - i0);
+
+        *flag = -1;
+        __QRPanel(A, v, flag, n, ld, i0, nb, tol);
+
+        if (*flag >= 0) {
+            STAT_LEAVE(ST_QR);
+
+            return;
+        }
+
+        int mTrail = m - i0 - nb;
+
+        if (mTrail <= 0) {
+            continue;
+        }
+
+        int nRem = n - i0;
+        double * __restrict__ T = (double *)calloc((size_t)nb * nb, sizeof(double));
+        double * __restrict__ Vt = (double *)calloc((size_t)nRem * nb, sizeof(double));
+        double * __restrict__ W = (double *)calloc((size_t)mTrail * nb, sizeof(double));
+        double * __restrict__ Z = (double *)calloc((size_t)mTrail * nb, sizeof(double));
+        double * __restrict__ Vr = (double *)calloc((size_t)nb * nRem, sizeof(double));
+
+        for (int t = 0; t < nb; t++) {
+            Vt[t * nb + t] = 1;
+            Vr[t * nRem + t] = 1;
+
+            for (int k = t + 1; k < nRem; k++) {
+                Vt[k * nb + t] = A[(size_t)(i0 + t) * ld + i0 + k];
+                Vr[t * nRem + k] = Vt[k * nb + t];
+            }
+        }
+
+        double y[PANEL_NB];
+
+        for (int t = 0; t < nb; t++) {
+            T[t * nb + t] = v[i0 + t];
+
+            for (int j = 0; j < t; j++) {
+                y[j] = A[(size_t)(i0 + j) * ld + i0 + t];
+
+                for (int k = i0 + t + 1; k < n; k++) {
+                    y[j] += A[(size_t)(i0 + j) * ld + k] * A[(size_t)(i0 + t) * ld + k];
+                }
+            }
+
+            for (int j = 0; j < t; j++) {
+                double z = 0;
+
+                for (int r = j; r < t; r++) {
+                    z += T[j * nb + r] * y[r];
+                }
+
+                T[j * nb + t] = -v[i0 + t] * z;
             }
         }
+
+        GEMM(A + (size_t)(i0 + nb) * ld + i0, Vt, W, mTrail, nRem, nb, ld, nb, nb, tunePnl, DT_DOUBLE);
+        GEMM(W, T, Z, mTrail, nb, nb, nb, nb, nb, tunePnl, DT_DOUBLE);
+
+        for (int i = 0; i < mTrail * nb; i++) {
+            Z[i] = -Z[i];
+        }
+
+        GEMM(Z, Vr, A + (size_t)(i0 + nb) * ld + i0, mTrail, nb, nRem, nb, nRem, ld, tunePnl, DT_DOUBLE);
+
+        free(T);
+        free(Vt);
+        free(Vr);
+        free(W);
+        free(Z);
     }
 
-    if (n == m & fabs(A[n - 1][n - 1]) < tol) {
+    if (n == m & fabs(A[(n - 1) * ld + n - 1]) < tol) {
         *flag = n - 1;
     } else {
         *flag = m;
     }
 
+    STAT_LEAVE(ST_QR);
+
     return;
-}
\ No newline at end of file
+}
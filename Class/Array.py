@@ -13,6 +13,41 @@ Since these three classes are so closely associated, they are implemented in a s
 """
 
 
+def _rsub(x: Any, y: Any) -> Any:
+    return y - x
+
+
+def _rtruediv(x: Any, y: Any) -> Any:
+    return y / x
+
+
+def _rfloordiv(x: Any, y: Any) -> Any:
+    return y // x
+
+
+def _rpow(x: Any, y: Any) -> Any:
+    return y ** x
+
+
+def _rmod(x: Any, y: Any) -> Any:
+    return y % x
+
+
+# Operators which Mat and Vec can hand over to the native elementwise kernels,
+# mapped to the operator name CLib.EWISE understands and a flag marking the reflected variants.
+# The reflected operators are module-level named functions (instead of inline lambdas)
+# precisely so that they can serve as keys here.
+_EW_DISPATCH: Final[Dict[Callable, Tuple[str, bool]]] = {
+    add: ('add', False), sub: ('sub', False), _rsub: ('sub', True), mul: ('mul', False),
+    truediv: ('div', False), _rtruediv: ('div', True), floordiv: ('flrdiv', False), _rfloordiv: ('flrdiv', True),
+    pow: ('pow', False), _rpow: ('pow', True), mod: ('mod', False), _rmod: ('mod', True),
+    lt: ('lt', False), le: ('le', False), gt: ('gt', False), ge: ('ge', False), eq: ('eq', False), ne: ('ne', False)
+}
+# Below this # of elements, the marshaling round trip outweighs the native kernels
+# and the pure Python path is used instead.
+_EW_MIN: Final[int] = 4096
+
+
 class Arr:
     """
     Array class.
@@ -27,12 +62,63 @@ class Arr:
     """
 
     def __init__(self, elem: List, dim: List[int]) -> None:
-        # List of elements.
+        # List of elements. Assignment goes through the _elem property below.
         self._elem: List = elem
         # Dimension.
         self._dim: List[int] = dim
         # Counter for iteration. Used by built-ins __next__ and __iter__.
         self._curr: int = 0
+        # Version counter. Bumped by every in-place mutation; used to validate the flat buffer cache.
+        self._ver: int = 0
+        # Cached flat buffer for native calls. Maintained by CLib; refer to Mat.buf_get.
+        self._buf: Optional[Tuple] = None
+        # Pending elementwise expression. Set by Mat.from_expr, cleared by Mat._force.
+        self._expr: Optional[Tuple] = None
+        # Set while the cached buffer may be captured by a pending expression; refer to Mat.buf_share.
+        self._shared: bool = False
+        # Set once self has been packed into a struct; refer to Mat.buf_pack.
+        self._packed: bool = False
+
+    """
+    LAZY MATERIALIZATION
+
+    A matrix or vector coming out of a native kernel is held as its flat typed buffer alone
+    (refer to Mat.from_buf); the nested element lists do not exist yet.
+    Every internal access to the elements goes through the _elem property,
+    which builds the lists from the buffer on first demand.
+    Chained native calls therefore pass results around as bare buffers with a dimension descriptor
+    and never pay the O(elements) nested representation in between.
+    """
+
+    @property
+    def _elem(self) -> List:
+        if self._raw is None:
+            self._materialize()
+
+        return self._raw
+
+    @_elem.setter
+    def _elem(self, elem: List) -> NoReturn:
+        self._raw = elem
+
+    @property
+    def lazy(self) -> bool:
+        """
+        True iff the nested element lists have not been materialized yet.
+
+        A lazy matrix(vector) is backed by its flat buffer(or pending expression) alone,
+        which can only have come out of a native kernel; its elements are therefore known
+        to be numeric without scanning them. MatFun.t relies on this.
+        """
+        return self._raw is None
+
+    def _materialize(self) -> NoReturn:
+        """
+        Builds the nested element lists from the flat buffer.
+
+        Overridden by Mat and Vec; a plain Arr is never buffer-backed.
+        """
+        pass
 
     """
     BUILT-IN OVERRIDING
@@ -48,7 +134,7 @@ class Arr:
         return self.__apply(other, sub)
 
     def __rsub__(self, other: Any) -> Arr:
-        return self.__apply(other, lambda x, y: y - x)
+        return self.__apply(other, _rsub)
 
     def __mul__(self, other: Any) -> Arr:
         return self.__apply(other, mul)
@@ -66,19 +152,19 @@ class Arr:
         return self.__apply(other, truediv)
 
     def __rtruediv__(self, other: Any) -> Arr:
-        return self.__apply(other, lambda x, y: y / x)
+        return self.__apply(other, _rtruediv)
 
     def __floordiv__(self, other: Any) -> Arr:
         return self.__apply(other, floordiv)
 
     def __rfloordiv__(self, other: Any) -> Arr:
-        return self.__apply(other, lambda x, y: y // x)
+        return self.__apply(other, _rfloordiv)
 
     def __pow__(self, other: Any) -> Arr:
         return self.__apply(other, pow)
 
     def __rpow__(self, other: Any) -> Arr:
-        return self.__apply(other, lambda x, y: y ** x)
+        return self.__apply(other, _rpow)
 
     def __pos__(self) -> Arr:
         return self
@@ -90,7 +176,7 @@ class Arr:
         return self.__apply(other, mod)
 
     def __rmod__(self, other: Any) -> Arr:
-        return self.__apply(other, lambda x, y: y % x)
+        return self.__apply(other, _rmod)
 
     def __lt__(self, other: Any) -> Arr:
         return self.__apply(other, lt)
@@ -132,6 +218,7 @@ class Arr:
 
     def __setitem__(self, key: int, value: Any):
         self._elem[key] = value
+        self._ver += 1
 
     def __len__(self) -> int:
         return self._dim[0]
@@ -304,6 +391,14 @@ class Arr:
         Float can be used as an index, and it will be rounded.
         However, this may cause unexpected behaviors due to rounding.
 
+        Updating is copy-on-write: the returned array is a new object,
+        but the elements NOT touched by idx are shared with self, not duplicated.
+        This is safe because updating never mutates an element in place
+        (the touched ones are replaced by the new objects their recursive update returns)
+        and in-place utilities like rbind work on fresh copies (refer to MatFun.rbind).
+        An indexed write into an alias of a large array therefore copies
+        only the spine lists along the updated path, not the whole array.
+
         :param idx: Index chain.
         :param val: Value to be assigned.
 
@@ -329,7 +424,7 @@ class Arr:
             elif type(idx[0]) == Vec:
                 # [UpIdxListComp]
                 idx_set: Vec = idx[0]
-                elem: List = deepcopy(self._elem)
+                elem: List = list(self._elem)
 
                 # TODO: Empty index?
                 if len(idx_set) != len(val):
@@ -347,7 +442,7 @@ class Arr:
             else:
                 # [UpIdxSngl]
                 i: int = round(idx[0])
-                elem: List = deepcopy(self._elem)
+                elem: List = list(self._elem)
 
                 if i < 0 or i >= self._dim[0]:
                     raise ArrErr(Errno.IDX_BOUND, idx=i)
@@ -362,7 +457,7 @@ class Arr:
             elif type(idx[0]) == Vec:
                 # [UpIdxListDist]
                 idx_set: Vec = idx[0]
-                elem: List = deepcopy(self._elem)
+                elem: List = list(self._elem)
 
                 for i in range(len(idx_set)):
                     j = round(idx_set[i])
@@ -376,7 +471,7 @@ class Arr:
             else:
                 # [UpIdxSngl]
                 i: int = round(idx[0])
-                elem: List = deepcopy(self._elem)
+                elem: List = list(self._elem)
 
                 if i < 0 or i >= self._dim[0]:
                     raise ArrErr(Errno.IDX_BOUND, idx=i)
@@ -609,6 +704,8 @@ class Arr:
 
         :return: Array (or its subclasses) after appending.
         """
+        self._ver += 1
+
         if type(v) == list:
             self._elem += v
             self._dim[0] += len(v)
@@ -647,10 +744,6 @@ class Mat(Arr):
     All exceptions raised here should be caught by Interp class.
     Then the erroneous position in the raw input string with the string itself should be properly assigned.
     """
-    # Block size for parallel matrix multiplication.
-    # Refer to the comments of CLib.GEMM.
-    __BLK_SZ: Final[int] = 500
-
     def __init__(self, elem: List, dim: List[int]) -> None:
         super().__init__(elem, dim)
 
@@ -668,7 +761,7 @@ class Mat(Arr):
         return self.__apply(other, sub)
 
     def __rsub__(self, other: Any) -> Mat:
-        return self.__apply(other, lambda x, y: y - x)
+        return self.__apply(other, _rsub)
 
     def __mul__(self, other: Any) -> Mat:
         return self.__apply(other, mul)
@@ -706,7 +799,7 @@ class Mat(Arr):
             if self._dim[1] != other._dim[0]:
                 raise ArrErr(Errno.DIM_MISMATCH, op='matrix multiplication', dim1=str(self._dim), dim2=str(other._dim))
 
-            return CLib.GEMM(self, other, Mat.__BLK_SZ)
+            return CLib.GEMM(self, other)
         else:
             if self._dim[1] != 1:
                 raise ArrErr(Errno.DIM_MISMATCH, op='matrix multiplication', dim1=str(self._dim), dim2='0(base type)')
@@ -739,7 +832,7 @@ class Mat(Arr):
                 raise ArrErr(Errno.DIM_MISMATCH, op='matrix multiplication', dim1=str(self._dim),
                              dim2=str([1, len(other)]))
 
-            return CLib.GEMM(other.promote(1), self, Mat.__BLK_SZ)
+            return CLib.GEMM(other.promote(1), self)
         else:
             if self._dim[0] != 1:
                 raise ArrErr(Errno.DIM_MISMATCH, op='matrix multiplication', dim1=str(self._dim), dim2='0(base type)')
@@ -750,28 +843,37 @@ class Mat(Arr):
         return self.__apply(other, truediv)
 
     def __rtruediv__(self, other: Any) -> Mat:
-        return self.__apply(other, lambda x, y: y / x)
+        return self.__apply(other, _rtruediv)
 
     def __floordiv__(self, other: Any) -> Mat:
         return self.__apply(other, floordiv)
 
     def __rfloordiv__(self, other: Any) -> Mat:
-        return self.__apply(other, lambda x, y: y // x)
+        return self.__apply(other, _rfloordiv)
 
     def __pow__(self, other: Any) -> Mat:
         return self.__apply(other, pow)
 
     def __rpow__(self, other: Any) -> Mat:
-        return self.__apply(other, lambda x, y: y ** x)
+        return self.__apply(other, _rpow)
 
     def __neg__(self) -> Mat:
+        if self._dim[0] * self._dim[1] >= _EW_MIN:
+            res: Optional[Mat] = CLib.EWLAZY(self, None, 'neg')
+
+            if res is None:
+                res = CLib.EWISE(self, None, 'neg')
+
+            if res is not None:
+                return res
+
         return Mat([-it for it in self._elem], self._dim.copy())
 
     def __mod__(self, other: Any) -> Mat:
         return self.__apply(other, mod)
 
     def __rmod__(self, other: Any) -> Mat:
-        return self.__apply(other, lambda x, y: y % x)
+        return self.__apply(other, _rmod)
 
     def __lt__(self, other: Any) -> Mat:
         return self.__apply(other, lt)
@@ -853,7 +955,7 @@ class Mat(Arr):
             elif type(idx[0]) == Vec:
                 # [UpIdxListComp]
                 idx_set: Vec = idx[0]
-                elem: List = deepcopy(self._elem)
+                elem: List = list(self._elem)
 
                 if len(idx_set) != len(val):
                     raise ArrErr(Errno.ASGN_N_MISS, need=len(idx_set), given=len(val))
@@ -870,7 +972,7 @@ class Mat(Arr):
             else:
                 # [UpIdxSngl]
                 i: int = round(idx[0])
-                elem: List = deepcopy(self._elem)
+                elem: List = list(self._elem)
 
                 if i < 0 or i >= self._dim[0]:
                     raise ArrErr(Errno.IDX_BOUND, idx=i)
@@ -885,7 +987,7 @@ class Mat(Arr):
             elif type(idx[0]) == Vec:
                 # [UpIdxListDist]
                 idx_set: Vec = idx[0]
-                elem: List = deepcopy(self._elem)
+                elem: List = list(self._elem)
 
                 for i in range(len(idx_set)):
                     j = round(idx_set[i])
@@ -899,7 +1001,7 @@ class Mat(Arr):
             else:
                 # [UpIdxSngl]
                 i: int = round(idx[0])
-                elem: List = deepcopy(self._elem)
+                elem: List = list(self._elem)
 
                 if i < 0 or i >= self._dim[0]:
                     raise ArrErr(Errno.IDX_BOUND, idx=i)
@@ -946,7 +1048,20 @@ class Mat(Arr):
 
         if type(other) == Vec:
             return op(self, other.promote(1))
-        elif type(other) == Mat:
+
+        # Large operands are handed over to the native elementwise kernels when possible.
+        # Fusable arithmetic is recorded lazily first (refer to CLib.EWLAZY); otherwise, or when
+        # fusion is not applicable, CLib.EWISE decides applicability itself and returns None if not.
+        if self._dim[0] * self._dim[1] >= _EW_MIN and op in _EW_DISPATCH:
+            res: Optional[Mat] = CLib.EWLAZY(self, other, *_EW_DISPATCH[op])
+
+            if res is None:
+                res = CLib.EWISE(self, other, *_EW_DISPATCH[op])
+
+            if res is not None:
+                return res
+
+        if type(other) == Mat:
             # [BinOpComp]
             if self._dim[0] != other._dim[0]:
                 raise ArrErr(Errno.DIM_MISMATCH, op='componentwise binary operation', dim1=str(self._dim),
@@ -961,6 +1076,31 @@ class Mat(Arr):
     FORMATTING LOGIC
     """
 
+    def _it_at(self, i: int) -> Any:
+        """
+        Reads the element at flat row-major position i WITHOUT materializing the rows.
+
+        The formatting logic only ever shows a window bounded by the display size,
+        but reaching the elements through the element lists would build
+        the whole nested representation of a buffer backed result first (refer to Mat.from_buf),
+        which costs O(elements) interpreted work and transiently doubles memory.
+        Going through this accessor keeps echoing such a result O(window):
+        the window is read straight out of the flat buffer.
+        (A pending elementwise expression still has to be forced first,
+        but that is one fused native pass, refer to Mat._force.)
+
+        :param i: Flat row-major position of the element.
+
+        :return: The element.
+        """
+        if self._raw is not None:
+            return self._raw[i // self._dim[1]]._it_at(i % self._dim[1])
+
+        if self._expr is not None:
+            self._force()
+
+        return self._buf[0][i]
+
     def format(self, w: int, h: int, it_w: int, h_remain: bool = False) -> Union[str, Tuple[str, int]]:
         """
         Formats matrix.
@@ -1016,13 +1156,15 @@ class Mat(Arr):
             c_cnt = min(c_cnt, self._dim[1])
 
         pool: List[List[Optional[str]]] = [[None for _ in range(c_cnt)] for _ in range(m)]
-        qt: bool = (type(self._elem[0][0]) == str)
+        # Only the displayable window is read, through _it_at so that a buffer backed result
+        # is never materialized just to be echoed.
+        qt: bool = (type(self._it_at(0)) == str)
         # Refer to the comments of Vec.format.
         it_w, mat_it_w = 0, it_w - 2 * qt
 
         for i in range(m):
             for j in range(c_cnt):
-                it_str: str = str(self._elem[i][j])
+                it_str: str = str(self._it_at(i * self._dim[1] + j))
 
                 if len(it_str) > mat_it_w:
                     it_str = it_str[:mat_it_w - 3] + '...'
@@ -1134,6 +1276,209 @@ class Mat(Arr):
 
         return self
 
+    """
+    FLAT BUFFER CACHE
+
+    Native calls need the elements as one flat row-major buffer.
+    Rebuilding that buffer from the nested lists costs O(elements) interpreted work per call,
+    so CLib caches it here after the first marshal (and after wrapping a native result)
+    and revalidates it cheaply through the version counters before reuse.
+
+    The buffer doubles as the sole representation of a freshly computed native result:
+    such a matrix starts with no element lists at all and builds them lazily
+    (refer to the LAZY MATERIALIZATION comments of Arr).
+    The buffers are tightly packed, ie. the stride b/w rows is exactly # of columns.
+    """
+
+    @staticmethod
+    def from_buf(buf: Any, t: Any, dim: List[int]) -> Mat:
+        """
+        Constructs a matrix directly over a flat row-major buffer.
+
+        The rows are NOT built here.
+        They are materialized on the first access through the element lists,
+        so a result which only flows into further native calls never leaves its flat form.
+
+        :param buf: Flat row-major buffer holding the elements.
+        :param t: ctypes element type of the buffer.
+        :param dim: Dimension of the matrix.
+
+        :return: Matrix backed by the buffer.
+        """
+        res: Mat = Mat([], dim)
+        res._raw = None
+        res.buf_set(buf, t)
+
+        return res
+
+    @staticmethod
+    def from_expr(expr: Tuple, dim: List[int]) -> Mat:
+        """
+        Constructs a PENDING matrix over a lazy elementwise expression.
+
+        Neither the buffer nor the rows exist yet:
+        the first demand for either (refer to buf_get and _materialize) forces the expression
+        through the fused kernel, after which the matrix behaves exactly like one built by from_buf.
+
+        :param expr: Expression node built by CLib.EWLAZY.
+        :param dim: Dimension of the matrix.
+
+        :return: Pending matrix holding the expression.
+        """
+        res: Mat = Mat([], dim)
+        res._raw = None
+        res._expr = expr
+
+        return res
+
+    def expr_get(self) -> Optional[Tuple]:
+        """
+        Returns the pending elementwise expression of self, or None if there is none.
+
+        Used by CLib.EWLAZY to chain a further operation onto a pending result without forcing it.
+        """
+        return self._expr
+
+    def _force(self) -> NoReturn:
+        """
+        Evaluates the pending elementwise expression into the flat buffer cache.
+
+        The whole chain recorded since the first lazy operation is computed here
+        in a single fused native pass(refer to CLib.EWFUSE).
+        """
+        n: int = self._dim[0] * self._dim[1] if type(self) == Mat else self._dim[0]
+        buf, t = CLib.EWFUSE(self._expr, n)
+        self._expr = None
+        self.buf_set(buf, t)
+
+    def _materialize(self) -> NoReturn:
+        if self._expr is not None:
+            self._force()
+
+        buf, t = self._buf[0], self._buf[1]
+        n: int = self._dim[1]
+        self._raw = [Vec(list(buf[i * n:(i + 1) * n])) for i in range(self._dim[0])]
+        # Refresh the cache so that the row snapshot covers the rows built just now.
+        self.buf_set(buf, t)
+
+    def buf_get(self) -> Optional[Tuple]:
+        """
+        Returns the cached flat buffer iff it still matches the elements.
+
+        Validity is checked against the version counter and dimension of self
+        and, for a matrix, the identity and version counter of every row,
+        so any in-place mutation anywhere in the structure invalidates the cache.
+        The check costs O(rows), not O(elements).
+        A matrix which has not been materialized has no rows to have mutated;
+        its buffer is the data itself and is valid by construction.
+        A pending matrix(refer to from_expr) is forced here first.
+
+        :return: Pair of the cached buffer and its ctypes element type, or None if absent or stale.
+        """
+        if self._expr is not None:
+            self._force()
+
+        if self._buf is None:
+            return None
+
+        buf, t, ver, dim, rows = self._buf
+
+        if ver != self._ver or dim != self._dim:
+            self._buf = None
+
+            return None
+
+        for i in range(len(rows)):
+            if rows[i][0] != id(self._raw[i]) or rows[i][1] != self._raw[i]._ver:
+                self._buf = None
+
+                return None
+
+        return buf, t
+
+    def buf_drop(self) -> NoReturn:
+        """
+        Detaches the cached flat buffer from the elements.
+
+        Called by the in-place factorization mode (refer to CLib.LU) after the kernel
+        has overwritten the buffer it was handed:
+        materialized rows still hold the original values, so the cache no longer describes them
+        and must not be reused by a later native call.
+        An unmaterialized matrix has no other storage;
+        it keeps the (overwritten) buffer and relies on the consumption of its bindings
+        (refer to SymTab.consume_v).
+        """
+        if self._raw is not None:
+            self._buf = None
+
+        self._shared = False
+
+    def buf_share(self) -> NoReturn:
+        """
+        Marks the cached flat buffer of self as captured by a pending elementwise expression.
+
+        Called by CLib.__EWOpnd whenever a lazy operation captures the buffer:
+        the expression reads it only when forced, which may be arbitrarily later,
+        so until then the buffer must not be overwritten.
+        The in-place factorization mode checks the mark (refer to buf_shared and CLib.LU)
+        and falls back to the copying path instead of factoring a captured buffer,
+        which would silently turn the pending result into factored garbage.
+        The mark is conservative: it outlives the expressions themselves
+        and clears only when a fresh buffer replaces the captured one.
+        """
+        self._shared = True
+
+    def buf_shared(self) -> bool:
+        """
+        Returns whether the cached flat buffer may be captured by a pending expression.
+
+        Refer to the comments of buf_share.
+        """
+        return self._shared
+
+    def buf_pack(self) -> NoReturn:
+        """
+        Marks self as packed into a struct.
+
+        Called by Interp whenever struct construction stores self as a member value.
+        Structs hold their members by REFERENCE, so from this point on a second name
+        (the member access) aliases self for the rest of its life:
+        consuming the variable bindings of self (refer to SymTab.consume_v)
+        no longer makes it unreachable, and the in-place factorization mode
+        (refer to buf_packed and CLib.LU) must fall back to the copying path
+        or the struct member would silently show the factored result.
+        Unlike the capture mark of buf_share, this mark describes the OBJECT,
+        not a particular buffer, so it never clears.
+        """
+        self._packed = True
+
+    def buf_packed(self) -> bool:
+        """
+        Returns whether self has been packed into a struct.
+
+        Refer to the comments of buf_pack.
+        """
+        return self._packed
+
+    def buf_set(self, buf: Any, t: Any) -> NoReturn:
+        """
+        Installs a flat buffer as the cache of self.
+
+        Installing a DIFFERENT buffer clears the capture mark of buf_share;
+        a refresh of the same buffer (refer to _materialize) keeps it,
+        since the captured storage is still the one being cached.
+
+        :param buf: Flat row-major buffer holding exactly the current elements.
+        :param t: ctypes element type of the buffer.
+        """
+        rows: Tuple = tuple((id(row), row._ver) for row in self._raw) if type(self) == Mat and self._raw is not None \
+            else ()
+
+        if self._buf is None or self._buf[0] is not buf:
+            self._shared = False
+
+        self._buf = (buf, t, self._ver, self._dim.copy(), rows)
+
     """
     GETTER & SETTER
     """
@@ -1184,7 +1529,7 @@ class Vec(Mat):
         return self.__apply(other, sub)
 
     def __rsub__(self, other: Any) -> Vec:
-        return self.__apply(other, lambda x, y: y - x)
+        return self.__apply(other, _rsub)
 
     def __mul__(self, other: Any) -> Vec:
         return self.__apply(other, mul)
@@ -1240,28 +1585,37 @@ class Vec(Mat):
         return self.__apply(other, truediv)
 
     def __rtruediv__(self, other: Any) -> Vec:
-        return self.__apply(other, lambda x, y: y / x)
+        return self.__apply(other, _rtruediv)
 
     def __floordiv__(self, other: Any) -> Vec:
         return self.__apply(other, floordiv)
 
     def __rfloordiv__(self, other: Any) -> Vec:
-        return self.__apply(other, lambda x, y: y // x)
+        return self.__apply(other, _rfloordiv)
 
     def __pow__(self, other: Any) -> Vec:
         return self.__apply(other, pow)
 
     def __rpow__(self, other: Any) -> Vec:
-        return self.__apply(other, lambda x, y: y ** x)
+        return self.__apply(other, _rpow)
 
     def __neg__(self) -> Vec:
+        if self._dim[0] >= _EW_MIN:
+            res: Optional[Vec] = CLib.EWLAZY(self, None, 'neg')
+
+            if res is None:
+                res = CLib.EWISE(self, None, 'neg')
+
+            if res is not None:
+                return res
+
         return Vec([-it for it in self._elem])
 
     def __mod__(self, other: Any) -> Vec:
         return self.__apply(other, mod)
 
     def __rmod__(self, other: Any) -> Vec:
-        return self.__apply(other, lambda x, y: y % x)
+        return self.__apply(other, _rmod)
 
     def __lt__(self, other: Any) -> Vec:
         return self.__apply(other, lt)
@@ -1383,17 +1737,18 @@ class Vec(Mat):
         if len(idx) > 1:
             return self.promote(len(idx) - 1).update(idx, val)
 
+        # The elements here are base types, which are immutable; they can be shared freely, no copy is needed.
         if type(val) == Vec:
             if idx[0] is None:
                 # [UpIdxAllCompBase]
                 if self._dim[0] != val._dim[0]:
                     raise ArrErr(Errno.ASGN_N_MISS, need=self._dim[0], given=val._dim[0])
 
-                return Vec(deepcopy(val._elem))
+                return Vec(list(val._elem))
             else:
                 # [UpIdxListCompBase]
                 idx_set: Vec = idx[0]
-                elem: List = deepcopy(self._elem)
+                elem: List = list(self._elem)
 
                 if idx_set._dim[0] != val._dim[0]:
                     raise ArrErr(Errno.ASGN_N_MISS, need=idx_set.dim[0], given=val._dim[0])
@@ -1404,17 +1759,17 @@ class Vec(Mat):
                     if j < 0 or j >= self._dim[0]:
                         raise ArrErr(Errno.IDX_BOUND, idx=j)
 
-                    elem[j] = deepcopy(val._elem[i])
+                    elem[j] = val._elem[i]
 
                 return Vec(elem)
         else:
             if idx[0] is None:
                 # [UpIdxAllDistBase]
-                return Vec([deepcopy(val) for _ in range(self._dim[0])])
+                return Vec([val] * self._dim[0])
             elif type(idx[0]) == Vec:
                 # [UpIdxListDistBase]
                 idx_set: Vec = idx[0]
-                elem: List = deepcopy(self._elem)
+                elem: List = list(self._elem)
 
                 for i in range(idx_set._dim[0]):
                     j = round(idx_set._elem[i])
@@ -1422,18 +1777,18 @@ class Vec(Mat):
                     if j < 0 or j >= self._dim[0]:
                         raise ArrErr(Errno.IDX_BOUND, idx=j)
 
-                    elem[j] = deepcopy(val)
+                    elem[j] = val
 
                 return Vec(elem)
             else:
                 # [UpIdxSnglBase]
                 i: int = round(idx[0])
-                elem: List = deepcopy(self._elem)
+                elem: List = list(self._elem)
 
                 if i < 0 or i >= self._dim[0]:
                     raise ArrErr(Errno.IDX_BOUND, idx=i)
 
-                elem[i] = deepcopy(val)
+                elem[i] = val
 
                 return Vec(elem)
 
@@ -1452,6 +1807,58 @@ class Vec(Mat):
         else:
             return self
 
+    """
+    FLAT BUFFER CACHE
+
+    Refer to the comments of Mat.
+    """
+
+    @staticmethod
+    def from_buf(buf: Any, t: Any) -> Vec:
+        """
+        Constructs a vector directly over a flat buffer.
+
+        Counterpart of Mat.from_buf; the element list is materialized lazily.
+
+        :param buf: Flat buffer holding the elements.
+        :param t: ctypes element type of the buffer.
+
+        :return: Vector backed by the buffer.
+        """
+        res: Vec = Vec([])
+        res._raw = None
+        res._dim = [len(buf)]
+        res.buf_set(buf, t)
+
+        return res
+
+    @staticmethod
+    def from_expr(expr: Tuple, n: int) -> Vec:
+        """
+        Constructs a PENDING vector over a lazy elementwise expression.
+
+        Counterpart of Mat.from_expr.
+
+        :param expr: Expression node built by CLib.EWLAZY.
+        :param n: Length of the vector.
+
+        :return: Pending vector holding the expression.
+        """
+        res: Vec = Vec([])
+        res._raw = None
+        res._dim = [n]
+        res._expr = expr
+
+        return res
+
+    def _materialize(self) -> NoReturn:
+        if self._expr is not None:
+            self._force()
+
+        buf, t = self._buf[0], self._buf[1]
+        self._raw = list(buf)
+        self.buf_set(buf, t)
+
     """
     APPLICATION LOGIC
 
@@ -1476,6 +1883,16 @@ class Vec(Mat):
         if type(other) == Mat or type(other) == Arr:
             return NotImplemented
 
+        # Refer to the comments in Mat.__apply.
+        if self._dim[0] >= _EW_MIN and op in _EW_DISPATCH:
+            res: Optional[Vec] = CLib.EWLAZY(self, other, *_EW_DISPATCH[op])
+
+            if res is None:
+                res = CLib.EWISE(self, other, *_EW_DISPATCH[op])
+
+            if res is not None:
+                return res
+
         if type(other) == Vec:
             # [BinOpComp]
             if self._dim[0] != other._dim[0]:
@@ -1491,6 +1908,24 @@ class Vec(Mat):
     FORMATTING LOGIC
     """
 
+    def _it_at(self, i: int) -> Any:
+        """
+        Reads the element at position i without materializing the element list.
+
+        Counterpart of Mat._it_at; refer to its comments.
+
+        :param i: Position of the element.
+
+        :return: The element.
+        """
+        if self._raw is not None:
+            return self._raw[i]
+
+        if self._expr is not None:
+            self._force()
+
+        return self._buf[0][i]
+
     def format(self, w: int, h: int, it_w: int, h_remain: bool = False) -> Union[str, Tuple[str, int]]:
         """
         Formats vector.
@@ -1520,7 +1955,7 @@ class Vec(Mat):
 
         :return: Formatted string.
         """
-        if len(self._elem) == 0:
+        if self._dim[0] == 0:
             return ('Empty vector', h - 1) if h_remain else 'Empty vector'
 
         # [Step 1]
@@ -1531,13 +1966,14 @@ class Vec(Mat):
         # Thus # of elements which will be actually formatted cannot exceed ceil(w/3)h.
         it_cnt: int = min(ceil(w / 3) * h, self._dim[0])
         pool: List[Optional[str]] = [None] * it_cnt
-        qt: bool = (type(self._elem[0]) == str)
+        # Only the displayable window is read; refer to the comments of Mat._it_at.
+        qt: bool = (type(self._it_at(0)) == str)
         # In case of string elements, we need double quotes(") enclosing each of them.
         # This can be considered as it_w being reduced by 2.
         it_w, max_it_w = 0, it_w - 2 * qt
 
         for i in range(it_cnt):
-            it_str: str = str(self._elem[i])
+            it_str: str = str(self._it_at(i))
 
             if len(it_str) > max_it_w:
                 it_str = it_str[:max_it_w - 3] + '...'
@@ -0,0 +1,223 @@
+from __future__ import annotations
+
+from .AST import *
+from .SymbolTable import *
+
+
+@final
+class Code:
+    """
+    Compiled code class.
+
+    Holds the linear bytecode of one input line
+    together with the compile time type snapshot of every variable the line reads.
+    The snapshot makes cached code self validating:
+    as long as the read variables still have the types they had when the line was checked,
+    replaying the bytecode is indistinguishable from running the full pipeline again.
+    For the instruction layout, refer to the comments of Comp class.
+
+    This class is the end of inheritance. No further inheritance is allowed.
+    """
+
+    def __init__(self, instr: List[Tuple], reads: List[Tuple[str, TSym]]) -> None:
+        # Bytecode instructions.
+        self.__instr: List[Tuple] = instr
+        # Pairs of read variable id and its type at compile time.
+        self.__reads: List[Tuple[str, TSym]] = reads
+
+    """
+    GETTER & SETTER
+    """
+
+    @property
+    def instr(self) -> List[Tuple]:
+        return self.__instr
+
+    @property
+    def reads(self) -> List[Tuple[str, TSym]]:
+        return self.__reads
+
+
+@final
+class Comp:
+    """
+    Compiler class.
+
+    Lowers a checked AST to a compact linear bytecode which Interp.run executes with a dispatch loop.
+    Compiled code is cached in the code table of SymTab keyed on the raw input string,
+    so feeding the same line again skips lexing, parsing, and semantic checking entirely.
+
+    The bytecode is a postfix encoding of the AST executed over an explicit value stack.
+    Everything the recursive interpreter reads from the checked AST besides the values of its children
+    (handles, inferred types, source positions for error reports) is baked into instruction operands,
+    so execution never touches the AST and, unlike the recursive interpreter,
+    never overwrites tokens, which is what makes replaying possible at all.
+    The instruction layouts are:
+        (PUSH, const)                     Push constant const.
+        (LOAD, id)                        Push the value of variable id.
+        (STORE, id, t)                    Assign the top of the stack to variable id whose new type is t.
+                                          The value is left on the stack as the result of the statement.
+        (CALL, fn, argc, pos)             Pop argc arguments, call handle fn, and push the result.
+        (CALLR, fn, pos)                  CALL for right associative binary operators:
+                                          the operands were evaluated right to left, so they pop in reversed order.
+        (MEM, id)                         Pack the top of the stack into the member pair (id, value).
+        (ARR, cnt, dept, base, pos)       Pop cnt elements and push an array construction of depth dept.
+                                          base lists which elements are of base type (for error reports).
+        (STRT, cnt)                       Pop cnt member pairs and push a struct.
+        (ASGNI, both_arr, tar_dept, pos)  Pop a value and an address pair (id, idx) and run assignment with indexing.
+                                          both_arr and tar_dept encode the promotion the checker inferred.
+
+    A cached line must not be replayed blindly: the code was compiled against the variable types
+    of that moment, and reassigning a variable with a value of another type would invalidate
+    the checks and the baked operands.
+    Therefore compilation records the type of every variable the line reads,
+    and lookup revalidates the snapshot against the type table before returning a hit.
+    The check costs O(read variables); a mismatch simply falls back to the full pipeline.
+
+    This class is implemented as a singleton. The singleton object will be instantiated at its first call.
+    This class is the end of inheritance. No further inheritance is allowed.
+    """
+    # Singleton object.
+    __inst: ClassVar[Comp] = None
+
+    @classmethod
+    def inst(cls, *args, **kwargs) -> Comp:
+        if not cls.__inst:
+            Comp.__inst = cls(*args, **kwargs)
+
+        return cls.__inst
+
+    def __init__(self) -> None:
+        # Instruction buffer of the line being compiled.
+        self.__instr: List[Tuple] = []
+        # Type snapshot buffer of the line being compiled.
+        self.__reads: List[Tuple[str, TSym]] = []
+
+    """
+    COMPILING LOGIC
+
+    Most of the logic below is for internal use only.
+    """
+
+    def __compile_asgn(self, ast: AST) -> NoReturn:
+        """
+        Compiles an assignment.
+
+        For a plain variable target only the RHS is compiled; the target id goes into the STORE operand,
+        together with the inferred RHS type which STORE replays into the type table
+        (the semantic checker updated it during the check and replays must reproduce that side effect).
+        For an indexed target, the address computation of the LHS is compiled as ordinary operator code
+        and ASGNI consumes the resulting (id, idx) pair.
+        For the promotion and degradation around Arr.update, refer to the comments of Interp.__interp_asgn.
+        """
+        if ast.ch[0].tok.t == TokT.VAR:
+            self.__compile_hlpr(ast.ch[1])
+            self.__instr.append((BCT.STORE, ast.ch[0].tok.v, ast.ch[1].t))
+        else:
+            self.__compile_hlpr(ast.ch[0])
+            self.__compile_hlpr(ast.ch[1])
+            self.__instr.append((BCT.ASGNI, ast.ch[0].t.t == T.ARR and ast.ch[1].t.t == T.ARR,
+                                 ast.ch[0].t.dept if ast.ch[0].t.t == T.ARR else 0, ast.tok.pos))
+
+    def __compile_hlpr(self, ast: AST) -> NoReturn:
+        """
+        Routes compiling logic according to the type of currently visiting node ast.
+
+        Children are emitted in exactly the order the recursive interpreter visits them,
+        so evaluation order (and thus any observable side effect) is preserved.
+        Note that a variable on the LHS of an assignment (true lval flag) compiles to its bare id;
+        the address computation routed to Sp.__addr expects the id, not the value.
+
+        :param ast: AST to be compiled.
+        """
+        if ast.tok.t == TokT.VAR:
+            if ast.lval:
+                self.__instr.append((BCT.PUSH, ast.tok.v))
+            else:
+                self.__reads.append((ast.tok.v, SymTab.inst().lookup_t(ast.tok.v)))
+                self.__instr.append((BCT.LOAD, ast.tok.v))
+        elif ast.tok.t == TokT.MEM:
+            self.__compile_hlpr(ast.ch[0])
+            self.__instr.append((BCT.MEM, ast.tok.v))
+        elif ast.tok.t == TokT.OP:
+            if ast.tok.v == OpT.ASGN:
+                self.__compile_asgn(ast)
+            elif ast.tok.v == OpT.EXP:
+                # Right to left associativity; refer to the comments of Interp.__interp_op.
+                self.__compile_hlpr(ast.ch[1])
+                self.__compile_hlpr(ast.ch[0])
+                self.__instr.append((BCT.CALLR, ast.call, ast.tok.pos))
+            else:
+                for node in ast.ch:
+                    self.__compile_hlpr(node)
+
+                self.__instr.append((BCT.CALL, ast.call, len(ast.ch), ast.tok.pos))
+        elif ast.tok.t == TokT.ARR:
+            for node in ast.ch:
+                self.__compile_hlpr(node)
+
+            self.__instr.append((BCT.ARR, len(ast.ch), ast.t.dept, [node.t.base for node in ast.ch], ast.tok.pos))
+        elif ast.tok.t == TokT.STRT:
+            for node in ast.ch:
+                self.__compile_hlpr(node)
+
+            self.__instr.append((BCT.STRT, len(ast.ch)))
+        elif ast.tok.t == TokT.FUN:
+            for node in ast.ch:
+                self.__compile_hlpr(node)
+
+            self.__instr.append((BCT.CALL, ast.call, len(ast.ch), ast.tok.pos))
+        else:
+            # Terminal node holding a constant (numeric, boolean, string, or void).
+            self.__instr.append((BCT.PUSH, ast.tok.v))
+
+    def compile(self, ast: AST, line: str) -> Code:
+        """
+        Compiles checked AST to bytecode and caches it.
+
+        Traverses AST in postorder and emits instructions following the logic described above.
+        The compiled code is registered in the code table of SymTab keyed on the raw input string.
+
+        :param ast: Checked AST to be compiled.
+        :param line: Raw input string.
+
+        :return: Compiled code.
+        """
+        self.__instr = []
+        self.__reads = []
+
+        self.__compile_hlpr(ast)
+
+        code: Code = Code(self.__instr, self.__reads)
+        SymTab.inst().update_c(line, code)
+
+        return code
+
+    def lookup(self, line: str) -> Optional[Code]:
+        """
+        Returns the cached code of line iff it is still valid.
+
+        Validity requires every variable the line reads to have exactly the type
+        it had when the line was compiled; refer to the comments above.
+
+        :param line: Raw input string.
+
+        :return: Cached code, or None if absent or stale.
+        """
+        code: Optional[Code] = SymTab.inst().lookup_c(line)
+
+        if code is None:
+            return None
+
+        for k, t in code.reads:
+            curr: Optional[TSym] = SymTab.inst().lookup_t(k)
+
+            if curr is None or not curr == t:
+                return None
+
+        return code
+
+
+"""
+COMMENT WRITTEN: 2026.9.1.
+"""
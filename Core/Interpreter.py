@@ -3,6 +3,7 @@ from __future__ import annotations
 from timeit import default_timer as timer
 from .AST import *
 from .SymbolTable import *
+from .Compiler import *
 from Class.Array import *
 from Class.Struct import *
 from Error.Exception import *
@@ -224,6 +225,13 @@ class Interp:
             for node in ast.ch:
                 self.__interp_hlpr(node)
 
+            # A struct holds its members by reference, so a matrix member stays reachable
+            # through the struct no matter what happens to its variable bindings.
+            # Mark it so the in-place factorization mode refuses its buffer (refer to Mat.buf_pack).
+            for node in ast.ch:
+                if isinstance(node.tok.v[1], Mat):
+                    node.tok.v[1].buf_pack()
+
             ast.tok.v = Strt({node.tok.v[0]: node.tok.v[1] for node in ast.ch}, [node.tok.v[0] for node in ast.ch])
         elif ast.tok.t == TokT.FUN:
             for node in ast.ch:
@@ -260,6 +268,173 @@ class Interp:
 
         return Printer.inst().format(self.__ast.tok.v)
 
+    """
+    BYTECODE EXECUTION
+
+    Dispatch loop for the bytecode emitted by Comp.
+    The semantics exactly follow the recursive logic above; the instruction handlers below mirror
+    __interp_op, __interp_asgn, __interp_arr, and __interp_hlpr over an explicit value stack.
+    Refer to the comments of Comp class for the instruction layouts.
+    Most of the logic below is for internal use only.
+    """
+
+    def __exec_asgn(self, stack: List, instr: Tuple) -> NoReturn:
+        """
+        Executes assignment with indexing.
+
+        The stack holds the address pair (id, idx) below the value to be assigned.
+        The value stays on the stack as the result of the statement.
+        For the logic itself, refer to the comments of __interp_asgn.
+        """
+        _, both_arr, tar_dept, pos = instr
+        val: Any = stack[-1]
+        id_, idx = stack[-2]
+        del stack[-2]
+
+        tar: Any = SymTab.inst().lookup_v(id_)
+
+        if both_arr:
+            val = val.promote(tar_dept - val.dept)
+
+        try:
+            if isinstance(tar, Arr):
+                new: Arr = tar.update(idx, val)
+                n: int = new.dept - tar.dept
+            else:
+                # Since base type has no update function, promote it once manually and then update.
+                new: Arr = Vec([tar]).update(idx, val)
+                n: int = tar.dept
+
+            SymTab.inst().update_v(id_, new.degrade(n))
+        except InterpErr as e:
+            e.pos = pos
+            e.line = self.__line
+
+            raise e
+
+    def __exec_arr(self, stack: List, instr: Tuple) -> NoReturn:
+        """
+        Executes array construction.
+
+        For the promotion and dimension check logic, refer to the comments of __interp_arr.
+
+        :raise InterpErr[DIM_MISMATCH]: If the dimensions of elements are not identical.
+        """
+        _, cnt, dept, base, pos = instr
+        vals: List = stack[len(stack) - cnt:]
+        del stack[len(stack) - cnt:]
+
+        elem: List = []
+        dim_old: List[int] = []
+
+        for i in range(cnt):
+            curr_v: Any = vals[i]
+
+            if isinstance(curr_v, Arr):
+                elem.append(deepcopy(curr_v).promote(dept - curr_v.dept - 1))
+                dim_new: List[int] = elem[-1].dim
+            elif dept > 1:
+                # Since base type has no promotion function, promote it once manually.
+                elem.append(Vec([deepcopy(curr_v)]).promote(dept - 2))
+                dim_new: List[int] = elem[-1].dim
+            else:
+                elem.append(deepcopy(curr_v))
+                dim_new: List[int] = []
+
+            if len(dim_old) != 0 and dim_old != dim_new:
+                raise InterpErr(pos, self.__line, Errno.DIM_MISMATCH, op='array construction',
+                                dim1='0(base type)' if base[i - 1] else str(vals[i - 1].dim),
+                                dim2='0(base type)' if base[i] else str(curr_v.dim))
+
+            dim_old = dim_new
+
+        if dept == 1:
+            stack.append(Vec(elem))
+        elif dept == 2:
+            stack.append(Mat(elem, [cnt, *dim_old]))
+        else:
+            stack.append(Arr(elem, [cnt, *dim_old]))
+
+    def run(self, code: Code, line: str, retype: bool = True) -> str:
+        """
+        Executes compiled bytecode.
+
+        The loop maintains an explicit value stack; every instruction pops its operands and pushes its result,
+        so after the last instruction the stack holds exactly the value of the whole line,
+        which is formatted by Printer.format like interp does.
+        Unlike interp, execution writes nothing back into an AST, so the same code can run any number of times.
+
+        All exceptions carry the source position baked into the erroneous instruction
+        with the raw input string, exactly as the recursive interpreter assigns them.
+
+        STORE replays the checked type of its target into the type table,
+        reproducing the side effect of the semantic checker when a cached line skips the check.
+        The pipelined front end of Pipe maintains the type table itself in source order instead
+        and passes retype False, so that replays of lines it has already moved past
+        cannot regress entries it advanced in the meantime; refer to the comments of Pipe class.
+
+        :param code: Compiled code to be executed.
+        :param line: Raw input string.
+        :param retype: If false, STORE does not replay types into the type table. (Default: True)
+
+        :return: Formatted result.
+
+        :raise InterpErr[KERNEL_ERR]: If Python raises exceptions during computation.
+        """
+        self.__line = line
+        stack: List = []
+
+        for instr in code.instr:
+            op: BCT = instr[0]
+
+            if op == BCT.PUSH:
+                stack.append(instr[1])
+            elif op == BCT.LOAD:
+                stack.append(SymTab.inst().lookup_v(instr[1]))
+            elif op == BCT.CALL or op == BCT.CALLR:
+                if op == BCT.CALL:
+                    _, fn, argc, pos = instr
+                    args: List = stack[len(stack) - argc:]
+                    del stack[len(stack) - argc:]
+                else:
+                    _, fn, pos = instr
+                    # The operands were evaluated right to left; the first argument is on top.
+                    args: List = [stack.pop(), stack.pop()]
+
+                try:
+                    stack.append(fn(*args))
+                except InterpErr as e:
+                    e.pos = pos
+                    e.line = self.__line
+
+                    raise e
+                except Exception as e:
+                    raise InterpErr(pos, self.__line, Errno.KERNEL_ERR, k_msg=str(e))
+            elif op == BCT.STORE:
+                if retype:
+                    SymTab.inst().update_t(instr[1], instr[2])
+
+                SymTab.inst().update_v(instr[1], stack[-1])
+            elif op == BCT.ASGNI:
+                self.__exec_asgn(stack, instr)
+            elif op == BCT.MEM:
+                stack[-1] = (instr[1], stack[-1])
+            elif op == BCT.ARR:
+                self.__exec_arr(stack, instr)
+            else:
+                pairs: List = stack[len(stack) - instr[1]:]
+                del stack[len(stack) - instr[1]:]
+
+                # A struct holds its members by reference; mark matrix members so the
+                # in-place factorization mode refuses their buffers (refer to Mat.buf_pack).
+                for _, v in pairs:
+                    if isinstance(v, Mat):
+                        v.buf_pack()
+
+                stack.append(Strt({id_: v for id_, v in pairs}, [id_ for id_, _ in pairs]))
+
+        return Printer.inst().format(stack[-1])
+
     """
     DEBUGGING
     """
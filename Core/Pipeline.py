@@ -0,0 +1,171 @@
+from __future__ import annotations
+
+from queue import Queue
+from threading import Event, Thread
+from .Parser import *
+from .SemanticChecker import *
+from .Compiler import *
+from .Interpreter import *
+from Function.Matrix import MatFun
+from Util.Printer import Printer
+
+
+@final
+class Pipe:
+    """
+    Batch pipeline class.
+
+    Runs a whole script (a list of input lines read in bulk by Reader.readall)
+    through the same front end and interpreter as the interactive loop of Main,
+    but as a two stage pipeline:
+    a worker thread runs the front end (code cache lookup, lexing, parsing,
+    semantic checking, and compilation) ahead on upcoming lines
+    while the main thread executes the compiled code of the current one.
+
+    Working ahead is sound because the front end OWNS the type table:
+    the semantic checker updates it as it checks assignments in source order,
+    a cache hit (which skips the checker) replays the STORE types of the cached code instead,
+    and execution runs with retype False so its lagging replays
+    cannot regress entries the front end has already advanced
+    (refer to the comments of Interp.run).
+    The one thing the front end cannot anticipate is a builtin which consumes
+    bindings at RUN time (refer to SymTab.consume_v and MatFun.lu):
+    lines calling such a builtin carry a fence, and the front end waits
+    until the main thread has executed the fenced line before checking further lines,
+    so a reference to a consumed variable is rejected
+    exactly as the sequential loop rejects it.
+    The main thread really overlaps with the worker whenever execution sits inside the native kernels
+    of CLib, which release the global interpreter lock; for pure Python lines the two threads
+    interleave instead, which costs nothing but gains nothing either.
+
+    Lines are handed over through a bounded queue, so the worker stays
+    at most __AHEAD lines ahead and results and error reports
+    come out in source order exactly as the interactive loop would print them.
+    Each queue entry carries its own raw line, so the existing Err machinery
+    reports every error against the line that caused it.
+    A failing line skips execution of that line only; like the interactive loop,
+    the batch continues with the next line, even if the failure is an exception
+    the Err machinery does not cover.
+
+    This class is implemented as a singleton. The singleton object will be instantiated at its first call.
+    This class is the end of inheritance. No further inheritance is allowed.
+    """
+    # Singleton object.
+    __inst: ClassVar[Pipe] = None
+    # Maximum # of lines the front end works ahead of execution.
+    __AHEAD: Final[ClassVar[int]] = 256
+    # Handles of builtins which may consume bindings at run time. Lines calling these are fenced.
+    __CONSUME: Final[ClassVar[Set[Callable]]] = {MatFun.lu, MatFun.chol}
+
+    @classmethod
+    def inst(cls, *args, **kwargs) -> Pipe:
+        if not cls.__inst:
+            Pipe.__inst = cls(*args, **kwargs)
+
+        return cls.__inst
+
+    def __init__(self) -> None:
+        pass
+
+    """
+    PIPELINE LOGIC
+    """
+
+    def __front(self, lines: List[str], q: Queue) -> NoReturn:
+        """
+        Front end stage. Runs in the worker thread.
+
+        For each line, it looks up the code cache and on a miss runs parse, check, and compile,
+        then hands the line over as a quadruple (line, code, error, fence):
+        code is None for blank lines, error is the caught Err of a failed front end, if any,
+        and fence is an Event set by the main thread once the line has been executed.
+        Only lines calling a binding-consuming builtin carry a fence (refer to the comments above);
+        after handing such a line over, the front end blocks on the fence
+        so every later line is checked against the consumed tables.
+        The end of the script is signaled by None.
+
+        :param lines: Lines of the script.
+        :param q: Queue connecting the stages.
+        """
+        for line in lines:
+            try:
+                code: Optional[Code] = Comp.inst().lookup(line)
+
+                if code is None:
+                    ast: AST = Parser.inst().parse(line)
+
+                    if ast is not None:
+                        ast = SemanticChk.inst().chk(ast, line)
+                        code = Comp.inst().compile(ast, line)
+                else:
+                    # A cache hit skips the checker, so replay the type updates the checker made
+                    # when the line was first checked; execution does not (refer to Interp.run).
+                    for instr in code.instr:
+                        if instr[0] == BCT.STORE:
+                            SymTab.inst().update_t(instr[1], instr[2])
+            except Err as e:
+                q.put((line, None, e, None))
+            else:
+                fence: Optional[Event] = None
+
+                if code is not None \
+                        and any(instr[0] == BCT.CALL and instr[1] in Pipe.__CONSUME for instr in code.instr):
+                    fence = Event()
+
+                q.put((line, code, None, fence))
+
+                if fence is not None:
+                    fence.wait()
+
+        q.put(None)
+
+    def run(self, lines: List[str]) -> NoReturn:
+        """
+        Executes a whole script through the pipeline.
+
+        Spawns the front end worker and executes the compiled lines as they arrive,
+        printing results and error reports in source order.
+        A fenced line wakes the waiting front end once executed, successfully or not.
+
+        :param lines: Lines of the script.
+        """
+        q: Queue = Queue(Pipe.__AHEAD)
+
+        Thread(target=self.__front, args=(lines, q), daemon=True).start()
+
+        while True:
+            it: Optional[Tuple] = q.get()
+
+            if it is None:
+                break
+
+            line, code, err, fence = it
+
+            try:
+                if err is not None:
+                    Printer.inst().print(err.msg)
+
+                    continue
+
+                if code is None:
+                    continue
+
+                try:
+                    res: str = Interp.inst().run(code, line, False)
+                except Err as e:
+                    Printer.inst().print(e.msg)
+                except Exception as e:
+                    # An exception the Err machinery does not cover must not kill the batch;
+                    # report it against its line and carry on like any other failed line.
+                    Printer.inst().print(line.rstrip() + '\n' + Printer.as_red(
+                        f'[Batch error] Line aborted by an unhandled {type(e).__name__}: {e}'))
+                else:
+                    Printer.inst().print(res)
+            finally:
+                if fence is not None:
+                    fence.set()
+
+
+"""
+COMMENT WRITTEN: 2026.9.1.
+"""
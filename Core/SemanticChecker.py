@@ -294,11 +294,11 @@ class SemanticChk:
             # [TAsgn]
             SymTab.inst().update_t(ast.ch[0].tok.v, val_t)
         else:
-            # TODO: Is this logic correct?
             # [TAsgnIdx]
-            t, _ = Sp.t_chk(ast.tok.v, [ast.ch[0].t, ast.ch[1].t])
-
-            if t is None:
+            # The indexed target accepts any subtype of its inferred (rvalue) type.
+            # Note that this covers the distributive case as well:
+            # base type b is a subtype of Arr[a, n] whenever b <: a, by rule [SubBaseArr].
+            if not val_t <= tar_t:
                 raise SemanticChkErr(ast.tok.pos, self.__line, Errno.ASGN_T_MISS, tar_t=str(ast.ch[0].t),
                                      val_t=str(ast.ch[1].t))
 
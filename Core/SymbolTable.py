@@ -10,7 +10,7 @@ class SymTab:
     Symbol table class.
 
     During interpretation process, some information needs to be tracked and symbol table does this tracking.
-    This class manages three tables: keyword table, type table, and symbol table.
+    This class manages four tables: keyword table, type table, symbol table, and code table.
 
     Keyword table is used by lexer to identify keywords like 'TRUE' and built-in function calls like 'idMat'.
     It uses keyword string as a key and has two entries:
@@ -27,6 +27,11 @@ class SymTab:
     Since this language does not support scoping (all variables are in global scope)
     there is no need to store additional information in type table and symbol table.
 
+    Code table is used by the compiler to cache the compiled bytecode of each input line.
+    It uses the raw input string as a key and has one entry, the compiled code.
+    Repeated lines thus skip lexing, parsing, and semantic checking entirely.
+    For the validity of cached code, refer to the comments of Comp class.
+
     This class is implemented as a singleton. The singleton object will be instantiated at its first call.
     This class is the end of inheritance. No further inheritance is allowed.
     """
@@ -49,6 +54,8 @@ class SymTab:
         self.__t: Dict[str, TSym] = {}
         # Symbol table.
         self.__v: Dict[str, Any] = {}
+        # Code table. The entries are Code objects; refer to the comments of Comp class.
+        self.__c: Dict[str, Any] = {}
 
     """
     LOOKUP & UPDATE
@@ -69,6 +76,9 @@ class SymTab:
     def lookup_v(self, k: str) -> Any:
         return self.__v.get(k, None)
 
+    def lookup_c(self, k: str) -> Any:
+        return self.__c.get(k, None)
+
     def update_kw(self, k: str, v: Any, t: TokT = TokT.FUN) -> NoReturn:
         self.__kword[k] = (t, v)
 
@@ -78,6 +88,27 @@ class SymTab:
     def update_v(self, k: str, v: Any) -> NoReturn:
         self.__v[k] = v
 
+    def update_c(self, k: str, c: Any) -> NoReturn:
+        self.__c[k] = c
+
+    def consume_v(self, v: Any) -> NoReturn:
+        """
+        Drops every variable currently bound to the object v.
+
+        Used by in-place builtins which overwrite their argument (refer to MatFun.lu):
+        after consumption the source variable is no longer defined,
+        so a later reference is rejected by the semantic checker
+        instead of silently reading the overwritten contents.
+        Bindings are matched by identity; other variables holding equal values are untouched.
+        Cached code reading a dropped variable fails its type snapshot validation
+        (refer to the comments of Comp class) and is recompiled, surfacing the same error.
+
+        :param v: The consumed object.
+        """
+        for k in [k for k, u in self.__v.items() if u is v]:
+            del self.__v[k]
+            self.__t.pop(k, None)
+
 
 """
 COMMENT WRITTEN: 2021.3.2.
@@ -86,6 +86,29 @@ class OpT(IntEnum):
     __repr__ = __str__
 
 
+@final
+class BCT(IntEnum):
+    """
+    Bytecode instruction types.
+
+    Refer to the comments of Comp class for the layout of each instruction.
+    """
+    PUSH = auto()   # Push a constant.
+    LOAD = auto()   # Push the value of a variable.
+    STORE = auto()  # Assign the top of the stack to a variable.
+    CALL = auto()   # Call an operator or function handle.
+    CALLR = auto()  # CALL whose two operands were evaluated in reversed order (for right associative operators).
+    MEM = auto()    # Pack the top of the stack into a struct member pair.
+    ARR = auto()    # Construct an array (or matrix or vector) from the top elements.
+    STRT = auto()   # Construct a struct from the top member pairs.
+    ASGNI = auto()  # Assignment with indexing.
+
+    def __str__(self) -> str:
+        return self.name
+
+    __repr__ = __str__
+
+
 @final
 class Errno(IntEnum):
     """
@@ -1,7 +1,10 @@
 from __future__ import annotations
 
+import mmap
+import struct
 from Class.Array import *
 from Class.Function import *
+from Class.Struct import *
 from Core.SymbolTable import *
 from Core.TypeSymbol import *
 from CDLL.CLibrary import *
@@ -13,6 +16,14 @@ MATRIX FUNCTIONS
 
 @final
 class MatFun:
+    # Layout of the binary matrix format. Refer to the comments of save.
+    __MAGIC: Final[ClassVar[bytes]] = b'TINYRMAT'
+    __FMT_VER: Final[ClassVar[int]] = 1
+    # Header struct: magic, version, dtype(0 for long, 1 for double), # of rows, and # of columns.
+    __FMT_HDR: Final[ClassVar[str]] = '<8sqqqq'
+    # Offset of the payload. The header is padded so that the payload sits cache line aligned.
+    __FMT_OFF: Final[ClassVar[int]] = 64
+
     def __init__(self) -> None:
         raise NotImplementedError
 
@@ -80,12 +91,66 @@ class MatFun:
                 FunTSym([ArrTSym(NumTSym(), 2)], ArrTSym(NumTSym(), 2))
                 )
         )
+        SymTab.inst().update_kw(
+            'crossprod',
+            Fun(MatFun.crossprod,
+                FunTSym([ArrTSym(NumTSym(), 2)], ArrTSym(NumTSym(), 2))
+                )
+        )
+        SymTab.inst().update_kw(
+            'sum',
+            Fun(MatFun.sum,
+                FunTSym([ArrTSym(NumTSym(), 2)], NumTSym())
+                )
+        )
+        SymTab.inst().update_kw(
+            'dot',
+            Fun(MatFun.dot,
+                FunTSym([ArrTSym(NumTSym(), 1), ArrTSym(NumTSym(), 1)], NumTSym())
+                )
+        )
+        SymTab.inst().update_kw(
+            'norm',
+            Fun(MatFun.norm,
+                FunTSym([ArrTSym(NumTSym(), 2), NumTSym()], NumTSym()),
+                [('p', '2')])
+        )
+        SymTab.inst().update_kw(
+            'min',
+            Fun(MatFun.min,
+                FunTSym([ArrTSym(NumTSym(), 2)], NumTSym())
+                )
+        )
+        SymTab.inst().update_kw(
+            'max',
+            Fun(MatFun.max,
+                FunTSym([ArrTSym(NumTSym(), 2)], NumTSym())
+                )
+        )
+        SymTab.inst().update_kw(
+            'solve',
+            Fun(MatFun.solve,
+                FunTSym([ArrTSym(NumTSym(), 2), ArrTSym(NumTSym(), 2)], ArrTSym(NumTSym(), 2))
+                )
+        )
+        SymTab.inst().update_kw(
+            'det',
+            Fun(MatFun.det,
+                FunTSym([ArrTSym(NumTSym(), 2)], NumTSym())
+                )
+        )
+        SymTab.inst().update_kw(
+            'inv',
+            Fun(MatFun.inv,
+                FunTSym([ArrTSym(NumTSym(), 2)], ArrTSym(NumTSym(), 2))
+                )
+        )
         SymTab.inst().update_kw(
             'lu',
             Fun(MatFun.lu,
-                FunTSym([ArrTSym(NumTSym(), 2), BoolTSym()],
-                        StrtTSym({'L': ArrTSym(NumTSym(), 2), 'U': ArrTSym(NumTSym(), 2)}))
-                )
+                FunTSym([ArrTSym(NumTSym(), 2), BoolTSym(), BoolTSym()],
+                        StrtTSym({'L': ArrTSym(NumTSym(), 2), 'U': ArrTSym(NumTSym(), 2)})),
+                [('cp', 'F'), ('inplace', 'F')])
         )
         # SymTab.inst().update_kw(
         #     'lu__',
@@ -98,8 +163,8 @@ class MatFun:
         SymTab.inst().update_kw(
             'chol',
             Fun(MatFun.chol,
-                FunTSym([ArrTSym(NumTSym(), 2)], StrtTSym({'L': ArrTSym(NumTSym(), 2)}))
-                )
+                FunTSym([ArrTSym(NumTSym(), 2), BoolTSym()], StrtTSym({'L': ArrTSym(NumTSym(), 2)})),
+                [('inplace', 'F')])
         )
         # SymTab.inst().update_kw(
         #     'chol__',
@@ -120,6 +185,28 @@ class MatFun:
         #                 StrtTSym({'QR': ArrTSym(NumTSym(), 2), 'aux': ArrTSym(NumTSym(), 1), 'flag': NumTSym()}))
         #         )
         # )
+        SymTab.inst().update_kw(
+            'save',
+            Fun(MatFun.save,
+                FunTSym([ArrTSym(NumTSym(), 2), StrTSym()], BoolTSym())
+                )
+        )
+        SymTab.inst().update_kw(
+            'load',
+            Fun(MatFun.load,
+                FunTSym([StrTSym()], ArrTSym(NumTSym(), 2))
+                )
+        )
+        SymTab.inst().update_kw(
+            'perfStats',
+            Fun(MatFun.perf_stats,
+                FunTSym([BoolTSym()],
+                        StrtTSym({counter: ArrTSym(NumTSym(), 1)
+                                  for counter in ['GEMM', 'GEMM_BATCH', 'GEMM_STRA', 'SYRK', 'TRSM', 'SOLVE', 'DET',
+                                                  'INV', 'LU', 'CHOL', 'QR', 'EWISE', 'EWFUSE', 'REDUCE', 'TRANS', 'pool',
+                                                  'marshal']})),
+                [('reset', 'F')])
+        )
 
     @staticmethod
     def o_mat(n: int) -> Mat:
@@ -272,39 +359,448 @@ class MatFun:
     @staticmethod
     def t(m: Mat) -> Mat:
         if type(m) == Mat:
+            # The nested comprehension gathers with a stride of the full row length;
+            # the native kernel does the same movement with cache-oblivious blocking.
+            # It moves elements through flat numeric buffers though, which would coerce
+            # booleans to 0/1 longs; transpose is pure movement, so those matrices
+            # (and empty ones) keep the Python gather. Only an UNMATERIALIZED matrix may
+            # skip the element scan: it came out of a native kernel and cannot hold
+            # booleans, whereas a materialized one may carry a buffer marshaled FROM
+            # booleans by an earlier elementwise call.
+            if m.nrow * m.ncol > 0 and ((m.buf_get() is not None and m.lazy)
+                                        or all(type(it) in (int, float) for row in m.elem for it in row.elem)):
+                return CLib.TRANS(m)
+
             return Mat([Vec([m[j][i] for j in range(m.nrow)]) for i in range(m.ncol)], [m.ncol, m.nrow])
         if type(m) == Vec:
             return Mat([Vec([m[i]]) for i in range(len(m))], [len(m), 1])
         else:
             return Mat([Vec([m])], [1, 1])
 
+    @staticmethod
+    def crossprod(m: Mat) -> Mat:
+        """
+        Computes the crossproduct t(m) %*% m.
+
+        Instead of building the transpose in Python and multiplying with GEMM,
+        it routes the computation to the dedicated SYRK kernel
+        which exploits the symmetry of the result and computes only half of it.
+
+        :param m: Matrix whose crossproduct is to be computed.
+
+        :return: t(m) %*% m.
+        """
+        if type(m) == Vec:
+            return MatFun.crossprod(m.promote(1))
+        elif type(m) != Mat:
+            return MatFun.crossprod(Mat([Vec([m])], [1, 1]))
+
+        # Block size comes from the tuned profile. Refer to the comments of CLib.GEMM.
+        return CLib.SYRK(m)
+
+    @staticmethod
+    def perf_stats(reset: bool = False) -> Strt:
+        """
+        Reads the hot-path instrumentation counters of the native kernels.
+
+        Each member of the returned struct is a pair: kernel members hold [invocations, seconds],
+        the pool member holds [tasks run, worker busy seconds],
+        and the marshal member holds [bytes converted, conversion seconds] on the Python side.
+        Refer to the comments of CLib.STATS for how to read them;
+        in short, a kernel whose wall time far exceeds the worker busy time waits on scheduling,
+        and a large marshal share means the conversion b/w Mat and flat buffers dominates.
+
+        :param reset: If true, all counters are cleared after being read. (Default: F)
+
+        :return: Struct of counter pairs described above.
+        """
+        stats = CLib.STATS(reset)
+
+        return Strt({counter: Vec([pair[0], pair[1]]) for counter, pair in stats.items()}, list(stats.keys()))
+
+    @staticmethod
+    def save(m: Mat, path: str) -> bool:
+        """
+        Saves a matrix to a binary file.
+
+        The file is a fixed 64 byte header (magic, format version, element type, and dimensions)
+        followed by the elements as one raw contiguous row major payload,
+        long or double depending on whether all elements are integer.
+        A cached flat buffer (refer to Mat.buf_get) is written out directly,
+        so saving a fresh native result is a single bulk write with no per-element conversion at all.
+
+        Unlike printing and re-parsing, the round trip through save and load
+        is I/O bound and exact: doubles are stored bit for bit, not via their decimal expansions.
+
+        :param m: Matrix to be saved.
+        :param path: Path of the file to be written.
+
+        :return: True.
+
+        :raise FunErr[FUN_ERR]: If m contains non-numeric elements or the file cannot be written.
+        """
+        if type(m) == Vec:
+            return MatFun.save(m.promote(1), path)
+        elif type(m) != Mat:
+            return MatFun.save(Mat([Vec([m])], [1, 1]), path)
+
+        cached = m.buf_get()
+
+        if cached is not None and cached[1] in (c_long, c_double):
+            buf, t = cached
+        else:
+            flat: List = [it for row in m.elem for it in row.elem]
+
+            try:
+                buf, t = array.array('q', flat), c_long
+            except (TypeError, OverflowError):
+                try:
+                    buf, t = array.array('d', flat), c_double
+                except TypeError:
+                    raise FunErr(Errno.FUN_ERR, detail='only numeric matrices can be saved')
+
+        hdr: bytes = struct.pack(MatFun.__FMT_HDR, MatFun.__MAGIC, MatFun.__FMT_VER,
+                                 0 if t == c_long else 1, m.nrow, m.ncol)
+
+        try:
+            with open(path, 'wb') as f:
+                f.write(hdr.ljust(MatFun.__FMT_OFF, b'\0'))
+                f.write(buf)
+        except OSError as os_err:
+            raise FunErr(Errno.FUN_ERR, detail=f'cannot write {path} ({os_err.strerror})')
+
+        return True
+
+    @staticmethod
+    def load(path: str) -> Mat:
+        """
+        Loads a matrix saved by save.
+
+        The payload is NOT read through Python: the file is memory mapped
+        and the matrix is constructed directly over a typed view of the mapping (refer to Mat.from_buf),
+        so loading costs O(header) regardless of the matrix size
+        and pages are faulted in only as the elements are actually touched.
+        Concurrent interpreter processes loading the same file share the physical pages;
+        the mapping is copy on write, so no computation can corrupt the file.
+
+        :param path: Path of the file to be read.
+
+        :return: Loaded matrix.
+
+        :raise FunErr[FUN_ERR]: If the file cannot be read or is not a valid matrix file.
+        """
+        try:
+            with open(path, 'rb') as f:
+                mm: mmap.mmap = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_COPY)
+        except (OSError, ValueError) as os_err:
+            raise FunErr(Errno.FUN_ERR, detail=f'cannot map {path} ({os_err})')
+
+        if len(mm) < MatFun.__FMT_OFF:
+            raise FunErr(Errno.FUN_ERR, detail=f'{path} is not a TinyR matrix file')
+
+        magic, ver, dt, nrow, ncol = struct.unpack_from(MatFun.__FMT_HDR, mm)
+
+        if magic != MatFun.__MAGIC or dt not in (0, 1) or nrow < 0 or ncol < 0:
+            raise FunErr(Errno.FUN_ERR, detail=f'{path} is not a TinyR matrix file')
+
+        if ver != MatFun.__FMT_VER:
+            raise FunErr(Errno.FUN_ERR, detail=f'unsupported matrix file version {ver}')
+
+        if len(mm) != MatFun.__FMT_OFF + 8 * nrow * ncol:
+            raise FunErr(Errno.FUN_ERR, detail=f'{path} is truncated')
+
+        buf = memoryview(mm)[MatFun.__FMT_OFF:].cast('q' if dt == 0 else 'd')
+
+        return Mat.from_buf(buf, c_long if dt == 0 else c_double, [nrow, ncol])
+
+    @staticmethod
+    def sum(v: Vec) -> Union[int, float]:
+        """
+        Computes the sum of all elements of v.
+
+        The whole pass runs through the native REDUCE kernel which streams the elements in parallel chunks
+        and combines the partial sums once at the end.
+        A matrix argument is reduced over all of its elements in row major order.
+        The sum of an integer array stays integer; otherwise the result is a double.
+
+        :param v: Vector(or matrix) whose elements are to be summed.
+
+        :return: Sum of all elements of v.
+
+        :raise FunErr[FUN_ERR]: If v is empty.
+        """
+        if type(v) != Vec and type(v) != Mat:
+            return v
+
+        res = CLib.REDUCE(v, 'sum')
+
+        if res is None:
+            raise FunErr(Errno.FUN_ERR, detail='cannot reduce an empty array')
+
+        return res[0]
+
+    @staticmethod
+    def dot(u: Vec, v: Vec) -> Union[int, float]:
+        """
+        Computes the dot product of u and v.
+
+        Multiplication and accumulation are fused in the native REDUCE kernel,
+        so no intermediate elementwise product is ever materialized.
+        The dot product of two integer vectors stays integer; otherwise the result is a double.
+
+        :param u: First operand.
+        :param v: Second operand. Must have the same length as u.
+
+        :return: Dot product of u and v.
+
+        :raise FunErr[FUN_ERR]: If the lengths of u and v differ or the operands are empty.
+        """
+        if type(u) != Vec:
+            u = Vec([u])
+
+        if type(v) != Vec:
+            v = Vec([v])
+
+        if len(u) != len(v):
+            raise FunErr(Errno.FUN_ERR,
+                         detail=f'dimension mismatch (cannot compute dot product of {u.dim} and {v.dim} vectors)')
+
+        res = CLib.REDUCE(u, 'dot', v)
+
+        if res is None:
+            raise FunErr(Errno.FUN_ERR, detail='cannot reduce an empty array')
+
+        return res[0]
+
+    @staticmethod
+    def norm(v: Vec, p: float = 2) -> float:
+        """
+        Computes the p-norm of v.
+
+        Supported values of p are 1(sum of absolute values), 2(Euclidean norm),
+        and 0 which by convention denotes the sup-norm(largest absolute value).
+        All three run through the native REDUCE kernel and always compute in double,
+        regardless of the element types of v.
+        A matrix argument is treated as the flat vector of its elements,
+        so norm(m) is the Frobenius norm of a matrix m.
+
+        :param v: Vector(or matrix) whose norm is to be computed.
+        :param p: Order of the norm. Must be 0, 1, or 2. (Default: 2)
+
+        :return: p-norm of v.
+
+        :raise FunErr[FUN_ERR]: If p is not 0, 1, or 2 or v is empty.
+        """
+        if type(v) != Vec and type(v) != Mat:
+            v = Vec([v])
+
+        if p == 1:
+            op: str = 'nrm1'
+        elif p == 2:
+            op = 'nrm2'
+        elif p == 0:
+            op = 'nrmInf'
+        else:
+            raise FunErr(Errno.FUN_ERR, detail=f'unsupported norm order (p must be 0, 1, or 2, given {p})')
+
+        res = CLib.REDUCE(v, op)
+
+        if res is None:
+            raise FunErr(Errno.FUN_ERR, detail='cannot reduce an empty array')
+
+        return res[0]
+
+    @staticmethod
+    def min(v: Vec) -> Union[int, float]:
+        """
+        Finds the smallest element of v.
+
+        The scan runs through the native REDUCE kernel; each parallel chunk tracks its own extremum
+        and the partial results are combined once at the end.
+        A matrix argument is scanned over all of its elements.
+        The minimum of an integer array stays integer.
+
+        :param v: Vector(or matrix) whose minimum is to be found.
+
+        :return: Smallest element of v.
+
+        :raise FunErr[FUN_ERR]: If v is empty.
+        """
+        if type(v) != Vec and type(v) != Mat:
+            return v
+
+        res = CLib.REDUCE(v, 'min')
+
+        if res is None:
+            raise FunErr(Errno.FUN_ERR, detail='cannot reduce an empty array')
+
+        return res[0]
+
+    @staticmethod
+    def max(v: Vec) -> Union[int, float]:
+        """
+        Finds the largest element of v.
+
+        The scan runs through the native REDUCE kernel; each parallel chunk tracks its own extremum
+        and the partial results are combined once at the end.
+        A matrix argument is scanned over all of its elements.
+        The maximum of an integer array stays integer.
+
+        :param v: Vector(or matrix) whose maximum is to be found.
+
+        :return: Largest element of v.
+
+        :raise FunErr[FUN_ERR]: If v is empty.
+        """
+        if type(v) != Vec and type(v) != Mat:
+            return v
+
+        res = CLib.REDUCE(v, 'max')
+
+        if res is None:
+            raise FunErr(Errno.FUN_ERR, detail='cannot reduce an empty array')
+
+        return res[0]
+
+    @staticmethod
+    def solve(m: Mat, b: Mat, tol: float = 1e-8) -> Union[Mat, Vec]:
+        """
+        Solves the linear system m %*% x = b.
+
+        The right hand side may be a vector or a matrix; with a matrix, every column is solved at once.
+        The whole solve (LU decomposition, permutation, and triangular solves) happens in one pass
+        through the native SOLVE kernel, avoiding any reassembly of triangles in interpreted code.
+
+        :param m: Coefficient matrix. Must be square.
+        :param b: Right hand side.
+        :param tol: Tolerance value. If abs(x) < tol, then x will be considered as 0. (Default: 1e-8)
+
+        :return: Solution x with the shape of b.
+
+        :raise FunErr[FUN_ERR]: If dimensions are incompatible or m is singular.
+        """
+        as_vec: bool = type(b) == Vec
+
+        if as_vec:
+            b = MatFun.t(b)
+        elif type(b) != Mat:
+            b = Mat([Vec([b])], [1, 1])
+
+        if not m.is_sqr:
+            raise FunErr(Errno.FUN_ERR, detail=f'coefficient matrix must be square (given {m.dim} matrix)')
+
+        if m.nrow != b.nrow:
+            raise FunErr(Errno.FUN_ERR,
+                         detail=f'dimension mismatch (cannot solve {m.dim} system against {b.dim} right hand side)')
+
+        x, flag = CLib.SOLVE(m, b, tol)
+
+        if flag != m.ncol:
+            raise FunErr(Errno.FUN_ERR, detail=f'singular coefficient matrix (rank {flag})')
+
+        return Vec([row[0] for row in x.elem]) if as_vec else x
+
+    @staticmethod
+    def det(m: Mat, tol: float = 1e-8) -> float:
+        """
+        Computes the determinant of m.
+
+        The computation runs entirely through the native DET kernel (LU decomposition with pivot sign tracking);
+        only the scalar result is marshaled back, so no intermediate matrix conversion is paid.
+        A singular input simply yields zero.
+
+        :param m: Matrix whose determinant is to be computed. Must be square.
+        :param tol: Tolerance value. If abs(x) < tol, then x will be considered as 0. (Default: 1e-8)
+
+        :return: Determinant of m.
+
+        :raise FunErr[FUN_ERR]: If m is not square.
+        """
+        if type(m) != Mat:
+            return m if type(m) != Vec else MatFun.det(m.promote(1))
+
+        if not m.is_sqr:
+            raise FunErr(Errno.FUN_ERR, detail=f'determinant needs a square matrix (given {m.dim} matrix)')
+
+        det, _ = CLib.DET(m, tol)
+
+        return det
+
+    @staticmethod
+    def inv(m: Mat, tol: float = 1e-8) -> Mat:
+        """
+        Computes the inverse of m.
+
+        The computation runs entirely through the native INV kernel,
+        which solves against the identity in one native pass (LU decomposition, permutation, triangular solves)
+        without round trips through Python between factorization and use.
+
+        :param m: Matrix to be inverted. Must be square and non-singular.
+        :param tol: Tolerance value. If abs(x) < tol, then x will be considered as 0. (Default: 1e-8)
+
+        :return: Inverse of m.
+
+        :raise FunErr[FUN_ERR]: If m is not square or singular.
+        """
+        if type(m) != Mat:
+            return MatFun.inv(m.promote(1) if type(m) == Vec else Mat([Vec([m])], [1, 1]))
+
+        if not m.is_sqr:
+            raise FunErr(Errno.FUN_ERR, detail=f'inverse needs a square matrix (given {m.dim} matrix)')
+
+        res, flag = CLib.INV(m, tol)
+
+        if flag != m.ncol:
+            raise FunErr(Errno.FUN_ERR, detail=f'singular matrix cannot be inverted (rank {flag})')
+
+        return res
+
     # TODO: Implement me
     @staticmethod
-    def lu(m: Mat, cp: bool = False, tol: float = 1e-8) -> Tuple[Mat, Vec]:
+    def lu(m: Mat, cp: bool = False, inplace: bool = False, tol: float = 1e-8) -> Tuple[Mat, Vec]:
+        """
+        With flag inplace, the factorization overwrites the flat buffer of m directly
+        instead of working on a defensive copy, halving peak memory.
+        The argument is CONSUMED: every variable bound to it is dropped from the symbol table
+        (refer to SymTab.consume_v) and referencing it afterwards is a semantic error.
+        """
         if m.ncol == 0:
             raise NotImplementedError
 
+        src: Mat = m
+
         if cp:
-            m, p, q, flag = CLib.LU(m, cp, tol)
+            m, p, q, flag = CLib.LU(m, cp, tol, inplace)
             print(m.format(100, 100, 10))
             print(p.format(100, 100, 10))
             print(q.format(100, 100, 10))
             print(flag)
         else:
-            m, p, flag = CLib.LU(m, cp, tol)
+            m, p, flag = CLib.LU(m, cp, tol, inplace)
             print(m.format(100, 100, 10))
             print(p.format(100, 100, 10))
             print(flag)
 
+        if inplace:
+            SymTab.inst().consume_v(src)
+
         return m
 
     # TODO: Implement me
     @staticmethod
-    def chol(m: Mat, tol: float = 1e-8):
+    def chol(m: Mat, inplace: bool = False, tol: float = 1e-8):
+        """
+        For flag inplace, refer to the comments of lu.
+        """
         if not m.is_sqr:
             raise NotImplementedError
 
-        m, flag = CLib.CHOL(m, tol)
+        src: Mat = m
+        m, flag = CLib.CHOL(m, tol, inplace)
+
+        if inplace:
+            SymTab.inst().consume_v(src)
+
         print(m.format(100, 100, 10))
         print(flag)
 
@@ -6,13 +6,25 @@ from Util.Reader import Reader
 from Util.Printer import Printer
 from Core.Parser import Parser
 from Core.SemanticChecker import SemanticChk
+from Core.Compiler import Comp, Code
 from Core.Interpreter import Interp
+from Core.Pipeline import Pipe
 from Core.AST import AST
+from typing import Optional
 from Error.Exception import Err
 from Core.Lexer import Lexer
 from Class.Array import Mat
 
 if __name__ == '__main__':
+    # Batch mode: a script passed as an argument is ingested in bulk and run through
+    # the pipelined front end. Refer to the comments of Pipe class.
+    if len(sys.argv) > 1:
+        with open(sys.argv[1]) as src:
+            InitMan.inst().init(src=src)
+            Pipe.inst().run(Reader.inst().readall())
+
+        sys.exit()
+
     InitMan.inst().init()
 
     while True:
@@ -27,13 +39,20 @@ if __name__ == '__main__':
         # Interp.inst().test(ast, line)
 
         try:
-            ast: AST = Parser.inst().parse(line)
+            # Repeated lines hit the code cache and skip the whole front end.
+            # For the validity of cached code, refer to the comments of Comp class.
+            code: Optional[Code] = Comp.inst().lookup(line)
+
+            if code is None:
+                ast: AST = Parser.inst().parse(line)
+
+                if ast is None:
+                    continue
 
-            if ast is None:
-                continue
+                ast = SemanticChk.inst().chk(ast, line)
+                code = Comp.inst().compile(ast, line)
 
-            ast = SemanticChk.inst().chk(ast, line)
-            res: str = Interp.inst().interp(ast, line)
+            res: str = Interp.inst().run(code, line)
         except Err as e:
             Printer.inst().print(e.msg)
         else:
@@ -42,6 +42,18 @@ class Reader:
         """
         return self.__src.readline()
 
+    def readall(self) -> List[str]:
+        """
+        Read all remaining lines at once including trailing newline characters.
+
+        Used by the batch mode (refer to the comments of Pipe class):
+        one bulk read through the underlying buffered reader
+        replaces one readline round trip per line of the script.
+
+        :return: List of read lines.
+        """
+        return self.__src.readlines()
+
     """
     GETTERS & SETTERS
     """